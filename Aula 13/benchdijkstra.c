@@ -0,0 +1,157 @@
+/*******************************************************************************
+
+ Programa de comparação das filas com prioridade do algoritmo de Dijkstra 
+ (amontoado binário e amontoado radix). Gera um dígrafo em grelha, semelhante a
+ uma rede de estradas, com custos inteiros pequenos, armazena-o no formato dos
+ ficheiros digrafo*.txt, lê-o com CreateFile e mede o tempo de Dijkstra com cada
+ uma das filas a partir dos mesmos vértices, e o da pesquisa bidirecional de 
+ DigraphShortestPath até um vértice de destino.
+
+ Utilização : bdig [número de vértices] [número de vértices de partida]
+
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+
+#include "digraph.h"  /* Ficheiro de interface do TAD */
+
+#define DEFAULT_VERTEXES 1000000
+#define DEFAULT_SOURCES 5
+#define MAX_COST 10
+#define FILENAME "digrafobench.txt"
+
+int WriteGridFile (char *, unsigned int);
+double RunDijkstra (PtDigraph, unsigned int, unsigned int, unsigned int[], int[], int[]);
+double RunShortestPath (PtDigraph, unsigned int, unsigned int, unsigned int[], int);
+
+int main (int argc, char *argv[])
+{
+  PtDigraph Digraph; unsigned int NVertexes = DEFAULT_VERTEXES, NSources = DEFAULT_SOURCES, I, Source, Target;
+  unsigned int *VertPred; int *VertCost, *Reference; clock_t Start; double Time;
+
+  if (argc > 1) NVertexes = (unsigned int) atol (argv[1]);
+  if (argc > 2) NSources = (unsigned int) atol (argv[2]);
+  if (NVertexes < 2 || NSources == 0)
+  {
+    fprintf (stderr, "Utilizacao: %s [vertices] [vertices de partida]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (WriteGridFile (FILENAME, NVertexes))
+  {
+    fprintf (stderr, "Erro na escrita do ficheiro %s\n", FILENAME);
+    return EXIT_FAILURE;
+  }
+
+  Start = clock ();
+  if ((Digraph = CreateFile (FILENAME)) == NULL)
+  {
+    fprintf (stderr, "Erro na leitura do ficheiro %s\n", FILENAME);
+    return EXIT_FAILURE;
+  }
+  printf ("Leitura de %u vertices: %.3f s\n", NVertexes, (double) (clock () - Start) / CLOCKS_PER_SEC);
+
+  VertPred = (unsigned int *) malloc ((NVertexes + 1) * sizeof (unsigned int));
+  VertCost = (int *) malloc (NVertexes * sizeof (int));
+  Reference = (int *) malloc (NVertexes * sizeof (int));
+  if (VertPred == NULL || VertCost == NULL || Reference == NULL)
+  {
+    fprintf (stderr, "Memoria esgotada\n");
+    return EXIT_FAILURE;
+  }
+
+  for (I = 0; I < NSources; I++)
+  {
+    Source = 1 + I * (NVertexes / NSources); Target = 1 + (Source - 1 + NVertexes / 2) % NVertexes;
+    Time = RunDijkstra (Digraph, DIJKSTRA_BINARY, Source, VertPred, VertCost, NULL);
+    printf ("Dijkstra a partir de %u - binario: %.3f s", Source, Time);
+    memcpy (Reference, VertCost, NVertexes * sizeof (int));
+    Time = RunDijkstra (Digraph, DIJKSTRA_RADIX, Source, VertPred, VertCost, Reference);
+    if (Time < 0.0) { printf ("\nCustos diferentes entre as filas com prioridade!\n"); return EXIT_FAILURE; }
+    printf (" / radix: %.3f s", Time);
+    Time = RunShortestPath (Digraph, Source, Target, VertPred, Reference[Target-1]);
+    if (Time < 0.0) { printf ("\nCusto diferente no caminho ate %u!\n", Target); return EXIT_FAILURE; }
+    printf (" / bidirecional ate %u: %.3f s\n", Target, Time);
+  }
+
+  free (VertPred); free (VertCost); free (Reference);
+  Destroy (&Digraph);
+  remove (FILENAME);
+
+  return EXIT_SUCCESS;
+}
+
+/* Escreve no ficheiro pfilename um dígrafo com pnv vértices dispostos numa grelha quadrada, com arcos nos dois sentidos entre vizinhos horizontais e verticais e custos aleatórios entre 1 e MAX_COST. Devolve 0 em caso de sucesso ou 1 se não conseguir abrir o ficheiro. */
+
+int WriteGridFile (char *pfilename, unsigned int pnv)
+{
+  FILE *PtF; unsigned int Side, V, NEdges = 0, Pass;
+
+  if ((PtF = fopen (pfilename, "w")) == NULL) return 1;
+
+  for (Side = 1; Side * Side < pnv; Side++) ;  /* lado da grelha */
+  srand (1);
+
+  for (Pass = 0; Pass < 2; Pass++)  /* contar as arestas e depois escrevê-las */
+  {
+    if (Pass == 1)
+    {
+      fprintf (PtF, "1\n%u %u\n", pnv, NEdges);
+      for (V = 1; V <= pnv; V++) fprintf (PtF, "%u\n", V);
+    }
+
+    for (V = 1; V <= pnv; V++)
+    {
+      if ((V - 1) % Side > 0)  /* vizinho da esquerda */
+      { if (Pass) fprintf (PtF, "%u %u %d\n", V, V - 1, 1 + rand () % MAX_COST); else NEdges++; }
+      if ((V - 1) % Side < Side - 1 && V < pnv)  /* vizinho da direita */
+      { if (Pass) fprintf (PtF, "%u %u %d\n", V, V + 1, 1 + rand () % MAX_COST); else NEdges++; }
+      if (V > Side)  /* vizinho de cima */
+      { if (Pass) fprintf (PtF, "%u %u %d\n", V, V - Side, 1 + rand () % MAX_COST); else NEdges++; }
+      if (V + Side <= pnv)  /* vizinho de baixo */
+      { if (Pass) fprintf (PtF, "%u %u %d\n", V, V + Side, 1 + rand () % MAX_COST); else NEdges++; }
+    }
+  }
+
+  fclose (PtF);
+  return 0;
+}
+
+/* Executa o algoritmo de Dijkstra a partir do vértice pv com a fila com prioridade pkind e devolve o tempo gasto em segundos. Se preference não for nulo, compara os custos obtidos com os de referência e devolve -1 se forem diferentes. */
+
+double RunDijkstra (PtDigraph pdig, unsigned int pkind, unsigned int pv, unsigned int pvpred[], int pvcost[], int preference[])
+{
+  clock_t Start; double Time; unsigned int NVertexes, I;
+
+  DigraphSetPQueue (pdig, pkind);
+  VertexNumber (pdig, &NVertexes);
+
+  Start = clock ();
+  Dijkstra (pdig, pv, pvpred, pvcost, NULL);
+  Time = (double) (clock () - Start) / CLOCKS_PER_SEC;
+
+  if (preference != NULL)
+    for (I = 0; I < NVertexes; I++)
+      if (pvcost[I] != preference[I]) return -1.0;
+
+  return Time;
+}
+
+/* Executa DigraphShortestPath do vértice psrc para o vértice pdst, colocando o caminho em ppath, e devolve o tempo gasto em segundos ou -1 se o custo for diferente de preference. */
+
+double RunShortestPath (PtDigraph pdig, unsigned int psrc, unsigned int pdst, unsigned int ppath[], int preference)
+{
+  clock_t Start; double Time; int Cost = INT_MAX, Error;
+
+  Start = clock ();
+  Error = DigraphShortestPath (pdig, psrc, pdst, ppath, &Cost, NULL, NULL, NULL);
+  Time = (double) (clock () - Start) / CLOCKS_PER_SEC;
+
+  if (Error == NO_PATH ? preference != INT_MAX : Cost != preference) return -1.0;
+
+  return Time;
+}
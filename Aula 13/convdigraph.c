@@ -0,0 +1,59 @@
+/*******************************************************************************
+
+ Programa de conversão dos ficheiros de texto digrafo*.txt (formato de CreateFile
+ e StoreFile) para o formato binário CSR, que é projetado em memória por 
+ CSRMapFile sem qualquer leitura ou conversão. Depois da conversão, compara o 
+ tempo de leitura do ficheiro de texto com o da projeção do ficheiro binário.
+
+ Utilização : cdig ficheiro_de_texto ficheiro_binario
+
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "digraph.h"  /* Ficheiro de interface do TAD */
+
+int main (int argc, char *argv[])
+{
+  PtDigraph Digraph; PtDigraphCSR CSR; clock_t Start; double TextTime, MapTime;
+  unsigned int NVertexes, NEdges; int Error;
+
+  if (argc != 3)
+  {
+    fprintf (stderr, "Utilizacao: %s ficheiro_de_texto ficheiro_binario\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if ((Error = ConvertFile (argv[1], argv[2])) != OK)
+  {
+    fprintf (stderr, "Erro %d na conversao de %s para %s\n", Error, argv[1], argv[2]);
+    return EXIT_FAILURE;
+  }
+
+  /* tempo de leitura do ficheiro de texto */
+  Start = clock ();
+  Digraph = CreateFile (argv[1]);
+  TextTime = (double) (clock () - Start) / CLOCKS_PER_SEC;
+
+  /* tempo de projeção do ficheiro binário */
+  Start = clock ();
+  CSR = CSRMapFile (argv[2]);
+  MapTime = (double) (clock () - Start) / CLOCKS_PER_SEC;
+
+  if (Digraph == NULL || CSR == NULL)
+  {
+    fprintf (stderr, "Erro na leitura dos ficheiros %s e %s\n", argv[1], argv[2]);
+    return EXIT_FAILURE;
+  }
+
+  VertexNumber (Digraph, &NVertexes); EdgeNumber (Digraph, &NEdges);
+  printf ("%s -> %s: %u vertices e %u arestas\n", argv[1], argv[2], NVertexes, NEdges);
+  printf ("Leitura do texto: %.3f s / projecao do binario: %.3f s\n", TextTime, MapTime);
+
+  Destroy (&Digraph);
+  CSRDestroy (&CSR);
+
+  return EXIT_SUCCESS;
+}
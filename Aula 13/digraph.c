@@ -1,271 +1,699 @@
-/************ Implementao do Dgrafo Dinmico - digraph.c ************/
+/************ Implementação do Dígrafo Dinâmico - digraph.c ************/
+
+#define _POSIX_C_SOURCE 200112L	/* mmap e munmap, apesar de -ansi */
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <limits.h>
-
-#include "digraph.h"	/* interface do dgrafo */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <pthread.h>
+
+#include "digraph.h"	/* interface do dígrafo */
 #include "pqueue_dijkstra.h"	/* interface da fila com prioridade de Dijkstra */
 
-/* Pedro Miguel Andr Coelho   N 68803 */
+/* Pedro Miguel André Coelho   N 68803 */
 
-/************** Definio do Estrutura de Dados do Dgrafo *************/
+/************** Definição do Estrutura de Dados do Dígrafo *************/
 
 typedef struct binode *PtBiNode;
 typedef struct vertex *PtVertex;
 typedef struct edge *PtEdge;
 
-struct binode	/* definio de um bin genrico - definition of the generic double linked list node */
+struct vertex	/* definição de um vértice - definition of the vertex */
 {
-	unsigned int Number;	/* nmero do vrtice ou da aresta - number od the vertes or edge */
-	PtBiNode PtPrev;	/* ponteiro para o n anterior da lista - pointer to preview list node */
-	PtBiNode PtNext;	/* ponteiro para o n seguinte da lista - pointer to next list node */
-	PtBiNode PtAdj;	/* ponteiro para a lista de adjacncias - pointer to the adjacency list of edges */
-	void *PtElem;	/* ponteiro para o elemento da lista - pointer to the element (vertex or edge) of the list */
-	unsigned int Visit;	/* marcao de vrtice visitado - field for marquing the visited vertex */
+	unsigned int InDeg;	/* semigrau incidente do vértice - in degree */
+	unsigned int OutDeg;	/* semigrau emergente do vértice - out degree */
+	PtBiNode PtIn;	/* lista de arcos incidentes, se o índice existir - incoming arcs list, if indexed */
 };
 
-struct vertex	/* definio de um vrtice - definition of the vertex */
+struct edge	/* definição de uma aresta - definition of the edge */
 {
-	unsigned int InDeg;	/* semigrau incidente do vrtice - in degree */
-	unsigned int OutDeg;	/* semigrau emergente do vrtice - out degree */
+	int Cost;	/* custo da aresta - edge cost */
+	PtBiNode PtTwin;	/* binó gémeo na outra lista do arco, se indexado - twin node of the arc, if indexed */
 };
 
-struct edge	/* definio de uma aresta - definition of the edge */
+struct binode	/* definição de um binó genérico - definition of the generic double linked list node */
 {
-	int Cost;	/* custo da aresta - edge cost */
+	unsigned int Number;	/* número do vértice ou da aresta - number od the vertes or edge */
+	PtBiNode PtPrev;	/* ponteiro para o nó anterior da lista - pointer to preview list node */
+	PtBiNode PtNext;	/* ponteiro para o nó seguinte da lista - pointer to next list node */
+	PtBiNode PtAdj;	/* ponteiro para a lista de adjacências - pointer to the adjacency list of edges */
+	union	/* elemento da lista guardado no próprio binó - element (vertex or edge) stored inline in the node */
+	{
+		struct vertex Vertex;	/* semigraus, num binó da lista de vértices - degrees of a vertex node */
+		struct edge Edge;	/* custo, num binó de uma lista de adjacências - cost of an edge node */
+	} Elem;
+};
+
+struct slab	/* bloco de binós reservado pelo dígrafo - block of nodes owned by the digraph */
+{
+	struct slab *Next;	/* bloco reservado anteriormente - previously allocated block */
+	unsigned int Size;	/* capacidade do bloco - capacity of the block */
+	unsigned int Used;	/* binós já entregues - nodes already handed out */
+	unsigned int Refs;	/* dígrafos que usam o bloco (dono e cópias) - digraphs using the block (owner and copies) */
+	struct binode Nodes[1];	/* binós do bloco (Size elementos) - nodes of the block (Size elements) */
+};
+
+struct slabref	/* referência a um bloco de outro dígrafo - reference to a block of another digraph */
+{
+	struct slab *Slab;	/* bloco partilhado - shared block */
+	struct slabref *Next;	/* referência seguinte - next reference */
+};
+
+struct listshare	/* partilha de uma lista de adjacências entre cópias - adjacency list shared among copies */
+{
+	unsigned int Refs;	/* dígrafos que partilham a lista - digraphs sharing the list */
+	struct shareblock *Block;	/* bloco a que a partilha pertence - block holding this share */
+};
+
+struct shareblock	/* partilhas criadas por uma cópia - shares created by one copy */
+{
+	unsigned int Live;	/* partilhas ainda em uso - shares still in use */
+	struct listshare Shares[1];	/* partilhas do bloco - shares of the block */
+};
+
+#define	SLAB_MIN	64	/* capacidade do primeiro bloco - capacity of the first block */
+#define	SLAB_MAX	65536	/* capacidade máxima de um bloco normal - maximum capacity of a regular block */
+#define	STREAM_CHUNK	65536	/* bytes lidos de cada vez por CreateStream - bytes read per chunk by CreateStream */
+
+/******************** Conjuntos de Bits (Bitsets) *********************/
+
+typedef unsigned long BITWORD;	/* palavra de um conjunto de bits - word of a bitset */
+
+#define	WORD_BITS	(CHAR_BIT * sizeof (BITWORD))	/* bits por palavra - bits per word */
+#define	BIT_WORDS(n)	(((n) + WORD_BITS - 1) / WORD_BITS)	/* palavras para n bits - words for n bits */
+#define	BIT_TEST(set, i)	(((set)[(i) / WORD_BITS] >> ((i) % WORD_BITS)) & 1UL)
+#define	BIT_SET(set, i)	((set)[(i) / WORD_BITS] |= 1UL << ((i) % WORD_BITS))
+#define	BIT_CLEAR(set, i)	((set)[(i) / WORD_BITS] &= ~(1UL << ((i) % WORD_BITS)))
+
+struct digraph	/* definição do dígrafo - definition of the digraph/graph */
+{
+	PtBiNode Head;	/* ponteiro para a cabeça do dígrafo - pointer to digraph/graph head of the vertexes list */
+	unsigned int NVertexes;	/* número de vértices do dígrafo - number of vertexes */
+	unsigned int NEdges;	/* número de arestas do dígrafo - number of edges */
+	unsigned int Type;	/* tipo dígrafo (1) / grafo (0) - type of digraph (1) / graph (0) */
+	PtBiNode *Index;	/* tabela de acesso direto número -> vértice - direct-address table from number to vertex */
+	unsigned int IndexSize;	/* capacidade da tabela de acesso direto - capacity of the direct-address table */
+	unsigned int PQueueKind;	/* fila com prioridade de Dijkstra - Dijkstra's priority queue */
+	struct slab *Slabs;	/* blocos de binós do dígrafo - node blocks owned by the digraph */
+	PtBiNode FreeNodes;	/* lista de binós libertados - free list of released nodes */
+	unsigned int NNegative;	/* número de arcos de custo negativo - number of negative cost arcs */
+	unsigned int Incoming;	/* listas de arcos incidentes mantidas (1) ou não (0) - incoming lists maintained */
+	unsigned int Version;	/* contador de alterações da estrutura - structural change counter */
+	struct reverse *Reverse;	/* índice inverso em cache (ou NULL) - cached reverse adjacency index */
+	unsigned int *Order;	/* ordem topológica em cache (ou NULL) - cached topological order */
+	unsigned int OrderVersion;	/* versão do dígrafo ordenada - ordered version of the digraph */
+	int OrderStatus;	/* OK ou NO_DAG para a versão ordenada - OK or NO_DAG for the ordered version */
+	unsigned int Connectivity;	/* partição mantida nas inserções (1) ou não (0) - partition kept on insertions */
+	unsigned int *Parent;	/* partição união-procura das componentes (ou NULL) - union-find of the components */
+	unsigned char *Rank;	/* ordens da partição - ranks of the partition */
+	unsigned int PartitionSize;	/* números de vértice da partição - vertex numbers of the partition */
+	unsigned int PartitionVersion;	/* versão do dígrafo particionada - partitioned version of the digraph */
+	pthread_mutex_t CacheLock;	/* exclusão mútua da construção das caches - lock of the cache builds */
+	struct slabref *Borrowed;	/* blocos partilhados com outros dígrafos - blocks shared with other digraphs */
+	struct listshare **Share;	/* partilha de cada lista (ou NULL), pelo número - share of each list, by number */
+	BITWORD *Present;	/* números com vértice, seguidos do resumo por palavra (ou NULL) - numbers in use, then a per-word summary */
+};
+
+static pthread_mutex_t ShareLock = PTHREAD_MUTEX_INITIALIZER;	/* exclusão mútua das contagens de partilha - lock of the share counts */
+
+struct reverse	/* índice inverso dos arcos incidentes - reverse adjacency index of the incoming arcs */
+{
+	unsigned int Version;	/* versão do dígrafo indexada - indexed version of the digraph */
+	unsigned int Size;	/* números de vértice indexados (0 a Size-1) - indexed vertex numbers */
+	unsigned int *Offset;	/* início dos arcos incidentes de cada vértice (Size+1) - start of the incoming arcs */
+	unsigned int *Source;	/* vértice de origem de cada arco - source vertex of each arc */
+	int *Cost;	/* custo de cada arco - cost of each arc */
+};
+
+#define	RADIX_BITS	8	/* bits por dígito da ordenação radix - bits per radix sort digit */
+#define	RADIX_DIGITS	(1 << RADIX_BITS)
+#define	RADIX_MIN	65536	/* arcos por fio, no mínimo - minimum number of arcs per thread */
+#define	COST_KEY(c)	((unsigned int) (c) ^ 0x80000000U)	/* custo como chave sem sinal - cost as an unsigned key */
+
+struct arc	/* definição de um arco para a construção em bloco - definition of an arc for bulk construction */
+{
+	unsigned int V1;	/* vértice emergente - source vertex */
+	unsigned int V2;	/* vértice incidente - target vertex */
+	int Cost;	/* custo do arco - arc cost */
+};
+
+struct degreekey	/* vizinho a ordenar pelo grau na reordenação RCM - neighbour sorted by degree in RCM reordering */
+{
+	unsigned int Degree;	/* grau do vizinho - degree of the neighbour */
+	unsigned int Position;	/* posição de descoberta - discovery position */
+	unsigned int Index;	/* índice do vizinho - index of the neighbour */
+};
+
+struct allpairs	/* trabalho partilhado pelos fios de DigraphAllPairs - work shared by the DigraphAllPairs threads */
+{
+	PtDigraph Digraph;	/* dígrafo/grafo pesquisado (só leitura) - searched digraph/graph (read-only) */
+	PtBiNode Next;	/* próximo vértice de partida por atribuir - next source vertex to hand out */
+	pthread_mutex_t Lock;	/* exclusão mútua de Next e Error - mutual exclusion of Next and Error */
+	unsigned int Dim;	/* dimensão das matrizes - dimension of the matrices */
+	unsigned int *Pred;	/* matriz dos predecessores - predecessor matrix */
+	int *Cost;	/* matriz dos custos - cost matrix */
+	int Error;	/* primeiro erro de um fio - first error of a thread */
+};
+
+struct batcharc	/* arco de uma operação em lote - arc of a batch operation */
+{
+	unsigned int V1;	/* vértice emergente - source vertex */
+	unsigned int V2;	/* vértice incidente - target vertex */
+	unsigned int Op;	/* posição da operação na sequência - position of the operation in the array */
+};
+
+struct radixjob	/* parte da ordenação radix paralela dos arcos - share of the parallel radix sort of the arcs */
+{
+	struct arc *From;	/* arcos a ordenar nesta passagem - arcs sorted in this pass */
+	struct arc *To;	/* destino da passagem - destination of the pass */
+	unsigned int Begin;	/* primeiro arco do fio - first arc of the thread */
+	unsigned int End;	/* arco seguinte ao último do fio - arc after the last one of the thread */
+	unsigned int Shift;	/* deslocamento do dígito da passagem - shift of the digit of the pass */
+	unsigned int Count[RADIX_DIGITS];	/* contagens e depois posições por dígito - counts and then offsets per digit */
+};
+
+struct search	/* estado de uma pesquisa num sentido - state of a search in one direction */
+{
+	unsigned int Capacity;	/* números de vértice suportados (0 a Capacity-1) - supported vertex numbers */
+	unsigned int *Mark;	/* Epoch se alcançado, Epoch+1 se conhecido - Epoch if reached, Epoch+1 if settled */
+	unsigned int *Pred;	/* vértice anterior no caminho de cada vértice alcançado - previous vertex on the path */
+	int *Cost;	/* custo de cada vértice alcançado - cost of each reached vertex */
+	PtPQueue PQueue;	/* fila com prioridade reutilizável - reusable priority queue */
+	unsigned int PQueueKind;	/* implementação da fila - priority queue implementation */
+};
+
+struct query	/* contexto de uma consulta só de leitura - context of a read-only query */
+{
+	unsigned int Epoch;	/* marca da consulta atual (par) - mark of the current query (even) */
+	struct search Side[2];	/* pesquisa direta e inversa (só criada quando é precisa) - forward and backward search */
+	PtBiNode *Frontier;	/* fronteira das pesquisas em largura - breadth-first search frontier */
+};
+
+struct csr	/* definição do instantâneo CSR imutável - definition of the frozen CSR snapshot */
+{
+	unsigned int NVertexes;	/* número de vértices - number of vertexes */
+	unsigned int NEdges;	/* número de arestas - number of edges */
+	unsigned int NArcs;	/* número de arcos armazenados (2 por aresta num grafo) - number of stored arcs */
+	unsigned int Type;	/* tipo dígrafo (1) / grafo (0) - type of digraph (1) / graph (0) */
+	unsigned int MaxNumber;	/* maior número de vértice - highest vertex number */
+	unsigned int *Number;	/* número do vértice de cada índice - vertex number of each index */
+	unsigned int *Map;	/* índice de cada número de vértice - index of each vertex number */
+	unsigned int *Offset;	/* início das adjacências de cada índice - adjacency start of each index */
+	unsigned int *Target;	/* índice do vértice incidente de cada arco - target index of each arc */
+	int *Cost;	/* custo de cada arco - cost of each arc */
+	unsigned int PQueueKind;	/* fila com prioridade de Dijkstra - Dijkstra's priority queue */
+	void *Mapping;	/* ficheiro projetado em memória ou NULL - memory-mapped file or NULL */
+	size_t MappingSize;	/* dimensão da projeção - size of the mapping */
+	unsigned int *ROffset;	/* início dos arcos incidentes em cache (ou NULL) - cached start of the incoming arcs */
+	unsigned int *RSource;	/* índice de origem de cada arco incidente - source index of each incoming arc */
+};
+
+#define	NO_INDEX	UINT_MAX	/* número de vértice sem índice - vertex number without index */
+
+static pthread_mutex_t ReverseLock = PTHREAD_MUTEX_INITIALIZER;	/* exclusão mútua da construção das adjacências inversas - lock of the reverse adjacency builds */
+
+struct csrheader	/* cabeçalho do ficheiro binário CSR - header of the binary CSR file */
+{
+	unsigned int Magic;	/* identificação do formato e da ordem dos bytes - format and byte order tag */
+	unsigned int Version;	/* versão do formato - format version */
+	unsigned int Type;	/* tipo dígrafo (1) / grafo (0) - type of digraph (1) / graph (0) */
+	unsigned int NVertexes;	/* número de vértices - number of vertexes */
+	unsigned int NEdges;	/* número de arestas - number of edges */
+	unsigned int NArcs;	/* número de arcos armazenados - number of stored arcs */
+	unsigned int MaxNumber;	/* maior número de vértice - highest vertex number */
+	unsigned int Reserved;	/* reservado (zero) - reserved (zero) */
+};
+
+#define	CSR_MAGIC	0x31475244	/* "DRG1" em little-endian */
+#define	CSR_VERSION	1
+
+/*************** Pesquisa em Largura Paralela (CSRBreadthFirst) ***************/
+
+#define	BFS_ALPHA	14	/* passagem a ascendente: arcos da fronteira > arcos por explorar / BFS_ALPHA */
+#define	BFS_BETA	24	/* regresso a descendente: fronteira < vértices / BFS_BETA */
+#define	BFS_CHUNK	16	/* palavras da fronteira atribuídas de cada vez a um fio - frontier words handed out per grab */
+
+struct breadthpart	/* contagens de um fio de CSRBreadthFirst - counts of a CSRBreadthFirst thread */
+{
+	struct breadthjob *Job;	/* pesquisa partilhada - shared search */
+	unsigned int Count;	/* índices alcançados pelo fio no nível - indexes reached by the thread in the level */
+	unsigned int Arcs;	/* arcos emergentes desses índices - outgoing arcs of those indexes */
 };
 
-struct digraph	/* definio do dgrafo - definition of the digraph/graph */
+struct breadthjob	/* pesquisa partilhada pelos fios de CSRBreadthFirst - search shared by the CSRBreadthFirst threads */
 {
-	PtBiNode Head;	/* ponteiro para a cabea do dgrafo - pointer to digraph/graph head of the vertexes list */
-	unsigned int NVertexes;	/* nmero de vrtices do dgrafo - number of vertexes */
-	unsigned int NEdges;	/* nmero de arestas do dgrafo - number of edges */
-	unsigned int Type;	/* tipo dgrafo (1) / grafo (0) - type of digraph (1) / graph (0) */
+	PtDigraphCSR CSR;	/* instantâneo pesquisado (só leitura) - searched snapshot (read-only) */
+	unsigned int *ROffset;	/* início dos arcos incidentes de cada índice - start of the incoming arcs of each index */
+	unsigned int *RSource;	/* índice de origem de cada arco incidente - source index of each incoming arc */
+	BITWORD *Visit;	/* índices já alcançados - indexes already reached */
+	BITWORD *Frontier;	/* fronteira do nível atual - frontier of the current level */
+	BITWORD *Next;	/* fronteira do nível seguinte - frontier of the next level */
+	unsigned int Words;	/* palavras de cada conjunto de bits - words of each bitset */
+	unsigned int Cursor;	/* próxima palavra por atribuir - next word to hand out */
+	unsigned int Level;	/* distância dos índices alcançados no nível - hop distance of the indexes reached in the level */
+	unsigned int BottomUp;	/* nível ascendente (1) ou descendente (0) - bottom-up (1) or top-down (0) level */
+	unsigned int Count;	/* índices da fronteira atual - indexes of the current frontier */
+	unsigned int Unexplored;	/* arcos emergentes dos índices por alcançar - outgoing arcs of the unreached indexes */
+	unsigned int Done;	/* fronteira vazia - empty frontier */
+	unsigned int *Pred;	/* sequência dos predecessores - predecessor array */
+	int *Cost;	/* sequência das distâncias - hop distance array */
+	struct breadthpart *Parts;	/* contagens de cada fio - counts of each thread */
+	unsigned int NParts;	/* número de fios pedidos - number of requested threads */
+	pthread_mutex_t Lock;	/* exclusão mútua da barreira - mutual exclusion of the barrier */
+	pthread_cond_t Wake;	/* fim de uma ronda da barreira - end of a barrier round */
+	unsigned int Threads;	/* fios da barreira (0 enquanto são criados) - barrier threads (0 while being created) */
+	unsigned int Waiting;	/* fios à espera na barreira - threads waiting at the barrier */
+	unsigned int Round;	/* ronda da barreira - barrier round */
 };
 
-/***************** Prottipos dos Subprogramas Internos ****************/
+/***************** Protótipos dos Subprogramas Internos ****************/
 
-static PtVertex CreateVertex (void);
-static PtEdge CreateEdge (int);
-static PtBiNode CreateBiNode (unsigned int);
-static void DestroyBiNode (PtBiNode *);
+static PtBiNode CreateBiNode (PtDigraph, unsigned int);
+static void DestroyBiNode (PtDigraph, PtBiNode *);
+static int ReserveNodes (PtDigraph, unsigned int);
+static PtDigraph CopyVertexes (PtDigraph, unsigned int);
+static int ShareLists (PtDigraph, PtDigraph);
+static int OwnList (PtDigraph, PtBiNode);
+static void ReleaseShare (PtDigraph, unsigned int);
 static PtBiNode InPosition (PtBiNode, unsigned int);
 static PtBiNode OutPosition (PtBiNode, unsigned int);
-static int InsertEdge (PtBiNode, PtBiNode, int);
-static void DeleteEdge (PtBiNode, PtBiNode);
-static int DijkstraPQueue (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pcost[]);
-
-/********************** Definio dos Subprogramas *********************/
+static PtBiNode VertexPosition (PtDigraph, unsigned int);
+static PtBiNode PrevVertex (PtDigraph, unsigned int);
+static int GrowIndex (PtDigraph, unsigned int);
+static int InsertEdge (PtDigraph, PtBiNode, PtBiNode, int);
+static int LinkEdge (PtDigraph, PtBiNode, PtBiNode, PtBiNode, int);
+static void DeleteEdge (PtDigraph, PtBiNode, PtBiNode);
+static void UnlinkArc (PtDigraph, PtBiNode, PtBiNode);
+static void LinkIncoming (PtBiNode, PtBiNode, PtBiNode);
+static int DijkstraPQueue (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pcost[], PtQuery pquery);
+static void DijkstraSearch (PtDigraph, PtBiNode, PtQuery);
+static void DijkstraResult (PtDigraph, PtQuery, unsigned int [], int []);
+static int SPFASearch (PtDigraph, PtBiNode, PtQuery);
+static int TopologicalOrder (PtDigraph, unsigned int **);
+static int PrimForest (PtDigraph, struct arc *, unsigned int *);
+static void PrimRelax (PtPQueue, unsigned char *, unsigned int *, int *, unsigned int, unsigned int, int);
+static int KruskalForest (PtDigraph, struct arc *, unsigned int *);
+static int SortArcsByCost (struct arc *, unsigned int);
+static void RunRadixJobs (struct radixjob *, unsigned int, void *(*) (void *));
+static void *RadixCount (void *);
+static void *RadixScatter (void *);
+static unsigned int FindSet (unsigned int *, unsigned int);
+static unsigned int UnionSets (unsigned int *, unsigned char *, unsigned int, unsigned int);
+static int Partition (PtDigraph);
+static int SortBatchArcs (PtDigraph, struct batcharc *, unsigned int);
+static int GrowPartition (PtDigraph);
+static unsigned int PartitionValid (PtDigraph);
+static int DAGPaths (PtDigraph, unsigned int, unsigned int [], int [], unsigned int);
+static int QueryBegin (PtQuery, PtDigraph, unsigned int, unsigned int);
+static int CompareNumbers (const void *, const void *);
+static void *AllPairsWorker (void *);
+static int ParseNumber (char **, char *, long *);
+static int BulkInsertEdges (PtDigraph, struct arc *, unsigned int);
+static int SortArcs (PtDigraph, struct arc *, unsigned int, unsigned int *);
+static int StreamRecord (PtDigraph, char *, char *);
+static int StreamVertex (PtDigraph, unsigned int, PtBiNode *);
+static int StreamArc (PtDigraph, PtBiNode, PtBiNode, int);
+static int StreamFinish (PtDigraph);
+static PtBiNode SortAdjacency (PtBiNode, unsigned int);
+static unsigned int ReachSearch (PtBiNode *, PtBiNode, unsigned int *, unsigned int, PtBiNode *);
+static PtDigraphCSR CreateCSR (unsigned int, unsigned int, unsigned int);
+static unsigned int CSRSearch (unsigned int, unsigned int *, unsigned int *, unsigned char *, unsigned int *);
+static struct reverse *ReverseIndex (PtDigraph);
+static void FreeReverse (struct reverse *);
+static int BidirectionalSearch (PtDigraph, PtBiNode, PtBiNode, PtQuery, unsigned int *, int *);
+static void BidirectionalRelax (struct search *, struct search *, unsigned int, unsigned int, int, unsigned int, unsigned int *, int *);
+static int AStarSearch (PtDigraph, PtBiNode, PtBiNode, PtHeuristic, void *, PtQuery);
+static int ReorderCSR (PtDigraphCSR, unsigned int, unsigned int *);
+static int CompareKeys (const void *, const void *);
+static PtDigraph RelabelCSR (PtDigraphCSR, unsigned int *, unsigned int);
+static void SwapStructure (PtDigraph, PtDigraph);
+static int CSRReverse (PtDigraphCSR);
+static int CSRValid (PtDigraphCSR);
+static void *BreadthWorker (void *);
+static void BreadthTopDown (struct breadthpart *);
+static void BreadthBottomUp (struct breadthpart *);
+static void BreadthSwitch (struct breadthjob *);
+static void BreadthBarrier (struct breadthjob *);
+
+/********************** Definição dos Subprogramas *********************/
 
 PtDigraph Create (unsigned int ptype)
 {
 	PtDigraph Digraph;
 
 	if ((Digraph = (PtDigraph) malloc (sizeof (struct digraph))) == NULL)
-		return NULL;	/* alocar memria para o dgrafo */
-	Digraph->Head = NULL;	/* inicializa a cabea do dgrafo */
-	Digraph->NVertexes = 0;	/* inicializa o nmero de vrtices */
-	Digraph->NEdges = 0;	/* inicializa o nmero de arestas */
-	Digraph->Type = ptype;	/* inicializa o tipo dgrafo/grafo */
-
-	return Digraph;	/* devolve a referncia do dgrafo criado */
+		return NULL;	/* alocar memória para o dígrafo */
+	Digraph->Head = NULL;	/* inicializa a cabeça do dígrafo */
+	Digraph->NVertexes = 0;	/* inicializa o número de vértices */
+	Digraph->NEdges = 0;	/* inicializa o número de arestas */
+	Digraph->Type = ptype;	/* inicializa o tipo dígrafo/grafo */
+	Digraph->Index = NULL;	/* inicializa a tabela de acesso direto vazia */
+	Digraph->IndexSize = 0;
+	Digraph->PQueueKind = PQUEUE_BINARY;	/* inicializa a fila com prioridade de Dijkstra */
+	Digraph->Slabs = NULL;	/* inicializa os blocos de binós vazios */
+	Digraph->FreeNodes = NULL;
+	Digraph->NNegative = 0;	/* inicializa sem arcos de custo negativo */
+	Digraph->Incoming = 0;	/* inicializa sem listas de arcos incidentes */
+	Digraph->Version = 0;	/* inicializa as caches por construir */
+	Digraph->Reverse = NULL;
+	Digraph->Order = NULL;
+	Digraph->OrderVersion = 0; Digraph->OrderStatus = OK;
+	Digraph->Connectivity = 0;	/* inicializa a partição das componentes por construir */
+	Digraph->Parent = NULL; Digraph->Rank = NULL;
+	Digraph->PartitionSize = Digraph->PartitionVersion = 0;
+	Digraph->Borrowed = NULL;	/* inicializa sem listas partilhadas */
+	Digraph->Share = NULL;
+	Digraph->Present = NULL;	/* inicializa o conjunto dos números por construir */
+	if (pthread_mutex_init (&Digraph->CacheLock, NULL) != 0) { free (Digraph); return NULL; }
+
+	return Digraph;	/* devolve a referência do dígrafo criado */
 }
 
 int Destroy (PtDigraph *pdig)
 {
-	PtDigraph TmpDigraph = *pdig; PtBiNode Vertex, Edge;
+	PtDigraph TmpDigraph = *pdig; struct slab *Slab; struct slabref *Ref; unsigned int I;
 
 	if (TmpDigraph == NULL) return NO_DIGRAPH;
 
-	while (TmpDigraph->Head != NULL)	/* libertar a memria dos vrtices */
+	if (TmpDigraph->Share != NULL)	/* largar as listas partilhadas com cópias */
 	{
-		Vertex = TmpDigraph->Head;	/* vrtice da cabea do dgrafo */
-		TmpDigraph->Head = TmpDigraph->Head->PtNext;	/* atualizar cabea */
-
-		while (Vertex->PtAdj != NULL)	/* libertar a memria das arestas */
-		{
-			Edge = Vertex->PtAdj;	/* cabea da lista das arestas */
-			Vertex->PtAdj = Vertex->PtAdj->PtNext;	/* atualizar cabea */
-			free (Edge->PtElem);	/* libertar a memria da aresta */
-			free (Edge);	/* libertar o bin da lista de arestas */
-		}
+		for (I = 0; I < TmpDigraph->IndexSize; I++)
+			if (TmpDigraph->Share[I] != NULL) ReleaseShare (TmpDigraph, I);
+		free (TmpDigraph->Share);
+	}
 
-		free (Vertex->PtElem);	/* libertar a memria do vrtice */
-		free (Vertex);	/* libertar o bin da lista de vrtices */
+	pthread_mutex_lock (&ShareLock);
+	while (TmpDigraph->Slabs != NULL)	/* libertar os blocos com todos os vértices e arestas */
+	{				/* que não estejam a ser usados por cópias */
+		Slab = TmpDigraph->Slabs;
+		TmpDigraph->Slabs = Slab->Next;
+		if (--Slab->Refs == 0) free (Slab);
+	}
+	while ((Ref = TmpDigraph->Borrowed) != NULL)	/* e os blocos partilhados de que é o último utilizador */
+	{
+		TmpDigraph->Borrowed = Ref->Next;
+		if (--Ref->Slab->Refs == 0) free (Ref->Slab);
+		free (Ref);
 	}
+	pthread_mutex_unlock (&ShareLock);
 
-	free (TmpDigraph);	/* libertar a memria ocupada pelo dgrafo */
-	*pdig = NULL;	/* colocar a referncia do dgrafo a NULL */
+	free (TmpDigraph->Index);	/* libertar a tabela de acesso direto */
+	free (TmpDigraph->Present);
+	FreeReverse (TmpDigraph->Reverse);	/* libertar as caches */
+	free (TmpDigraph->Order);
+	free (TmpDigraph->Parent); free (TmpDigraph->Rank);
+	pthread_mutex_destroy (&TmpDigraph->CacheLock);
+	free (TmpDigraph);	/* libertar a memória ocupada pelo dígrafo */
+	*pdig = NULL;	/* colocar a referência do dígrafo a NULL */
 
 	return OK;
 }
 
 PtDigraph Copy (PtDigraph pdig)
 {
-  PtDigraph Copy; PtBiNode Vert, PEdge; PtEdge Edge;
+  PtDigraph Copy; PtBiNode Vert, PEdge, CVert, Prev; unsigned int NArcs = 0;
 
   if (pdig == NULL) return NULL;
 
-  Copy = Create (pdig->Type);
+  /* sem gémeos, a cópia partilha as listas de adjacências até uma delas ser alterada */
+  if (!pdig->Incoming || !pdig->Type)
+  {
+    if ((Copy = CopyVertexes (pdig, 0)) == NULL) return NULL;
+    if (ShareLists (pdig, Copy) != OK) Destroy (&Copy);
+    return Copy;
+  }
 
-  /* inserir os vrtices */
-  for (Vert = pdig->Head; Vert != NULL; Vert = Vert->PtNext)
-    if (InVertex (Copy, Vert->Number)) { Destroy (&Copy); return NULL; }
+  for (Vert = pdig->Head; Vert != NULL; Vert = Vert->PtNext) NArcs += Vert->Elem.Vertex.OutDeg;
 
-  /* inserir as arestas */
-  for (Vert = pdig->Head; Vert != NULL; Vert = Vert->PtNext)
-    for (PEdge = Vert->PtAdj; PEdge != NULL; PEdge = PEdge->PtNext)
+  /* copiar os vértices, com espaço reservado para todas as arestas */
+  if ((Copy = CopyVertexes (pdig, NArcs)) == NULL) return NULL;
+
+  /* copiar as listas de adjacências, já ordenadas, por acrescento */
+  for (Vert = pdig->Head, CVert = Copy->Head; Vert != NULL; Vert = Vert->PtNext, CVert = CVert->PtNext)
+    for (PEdge = Vert->PtAdj, Prev = NULL; PEdge != NULL; PEdge = PEdge->PtNext)
     {
-      Edge = (PtEdge) PEdge->PtElem;
-      if (InEdge (Copy, Vert->Number, PEdge->Number, Edge->Cost))
-      { Destroy (&Copy); return NULL; }
+      LinkEdge (Copy, CVert, Prev, Copy->Index[PEdge->Number], PEdge->Elem.Edge.Cost);
+      Prev = Prev == NULL ? CVert->PtAdj : Prev->PtNext;
     }
+  Copy->NEdges = pdig->NEdges;
 
-  return Copy;  /* devolver a referncia do Digrafo criado */
+  return Copy;  /* devolver a referência do Digrafo criado */
 }
 
 int InVertex (PtDigraph pdig, unsigned int pv)
 {
-	PtBiNode Insert, Node;	/* posio de insero e novo vrtice */
+	PtBiNode Insert, Node;	/* posição de inserção e novo vértice */
+	unsigned int Valid;
 
 	if (pdig == NULL) return NO_DIGRAPH;
+	if (VertexPosition (pdig, pv) != NULL) return REP_VERTEX;
+	if (GrowIndex (pdig, pv) != OK) return NO_MEM;
 
-					/* criar o bin e o vrtice */
-	if ((Node = CreateBiNode (pv)) == NULL) return NO_MEM;
-	if ((Node->PtElem = CreateVertex ()) == NULL)
-	{ free (Node); return NO_MEM; }
+					/* criar o binó e o vértice */
+	Valid = PartitionValid (pdig);
+	if ((Node = CreateBiNode (pdig, pv)) == NULL) return NO_MEM;
 
-					/* determinar posio de colocao e inserir o vrtice */
-	if (pdig->Head == NULL || pdig->Head->Number > pv)
-	{				/* insero  cabea do dgrafo */
+		/* o vértice de inserção é o de maior número inferior a pv */
+	Insert = PrevVertex (pdig, pv);
+
+					/* determinar posição de colocação e inserir o vértice */
+	if (Insert == NULL)
+	{				/* inserção à cabeça do dígrafo */
 		Node->PtNext = pdig->Head; pdig->Head = Node;
 		if (Node->PtNext != NULL) Node->PtNext->PtPrev = Node;
 	}
 	else
-	{				/* insero  frente do n de insero */
-		if ((Insert = InPosition (pdig->Head, pv)) == NULL)
-		{			/* insero sem sucesso, porque o vrtice j existe */
-			DestroyBiNode (&Node); return REP_VERTEX;
-		}
+	{				/* inserção à frente do nó de inserção */
 		Node->PtNext = Insert->PtNext;
 		if (Node->PtNext != NULL) Node->PtNext->PtPrev = Node;
 		Node->PtPrev = Insert; Insert->PtNext = Node;
 	}
 
-	pdig->NVertexes++;	/* atualizar o nmero de vrtices */
+	pdig->Index[pv] = Node;	/* registar o vértice na tabela de acesso direto */
+	pdig->NVertexes++;	/* atualizar o número de vértices */
+	if (pdig->Present != NULL)
+	{ BIT_SET (pdig->Present, pv); BIT_SET (pdig->Present + BIT_WORDS (pdig->IndexSize), pv / WORD_BITS); }
+
+	if (Valid && GrowPartition (pdig) == OK)
+	{				/* o novo vértice é uma nova componente */
+		pdig->Parent[pv] = pv; pdig->Rank[pv] = 0;
+		pdig->PartitionVersion = pdig->Version;
+	}
 	return OK;
 }
 
 int OutVertex (PtDigraph pdig, unsigned int pv)
 {
-	PtBiNode Vertex, Edge, Delete;	/* posio de remoo do vrtice */
+	PtBiNode Vertex, Edge, Delete;	/* posição de remoção do vértice */
 
 	if (pdig == NULL) return NO_DIGRAPH;
 	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
 
-					/* determinar posio de remoo do vrtice */
-	if ((Delete = OutPosition (pdig->Head, pv)) == NULL)
+					/* determinar posição de remoção do vértice */
+	if ((Delete = VertexPosition (pdig, pv)) == NULL)
 		return NO_VERTEX;
 
-	while (Delete->PtAdj != NULL)	/* remover a lista de adjacncias */
-	{	/* atualizar semigrau incidente da cabea da lista das arestas */
-		((PtVertex) Delete->PtAdj->PtAdj->PtElem)->InDeg--;
-		Edge = Delete->PtAdj;
-		Delete->PtAdj = Delete->PtAdj->PtNext;	/* atualizar cabea */
-		DestroyBiNode (&Edge);	/* destruir bin com aresta */
-		pdig->NEdges--;	/* atualizar o nmero de arestas */
+		/* tornar próprias, antes de qualquer remoção, as listas partilhadas que vão ser alteradas */
+	if (OwnList (pdig, Delete) != OK) return NO_MEM;
+	if (!pdig->Type)
+	{
+		for (Edge = Delete->PtAdj; Edge != NULL; Edge = Edge->PtNext)
+			if (OwnList (pdig, Edge->PtAdj) != OK) return NO_MEM;
+	}
+	else if (!pdig->Incoming)
+		for (Vertex = pdig->Head; Vertex != NULL; Vertex = Vertex->PtNext)
+			if (OutPosition (Vertex->PtAdj, pv) != NULL && OwnList (pdig, Vertex) != OK) return NO_MEM;
+
+	while (Delete->PtAdj != NULL)	/* remover a lista de adjacências */
+	{	/* num grafo, remover também a aresta simétrica da lista do vizinho */
+		if (!pdig->Type) DeleteEdge (pdig, Delete->PtAdj->PtAdj, Delete);
+		UnlinkArc (pdig, Delete, Delete->PtAdj);
+		pdig->NEdges--;	/* atualizar o número de arestas */
+	}
+
+	if (pdig->Type)	/* num dígrafo, remover os arcos incidentes */
+	{
+		if (pdig->Incoming)	/* pela lista de arcos incidentes do vértice */
+			while ((Edge = Delete->Elem.Vertex.PtIn) != NULL)
+			{
+				UnlinkArc (pdig, Edge->PtAdj, Edge->Elem.Edge.PtTwin);
+				pdig->NEdges--;
+			}
+		else	/* pelas listas de adjacências de todos os vértices */
+			for (Vertex = pdig->Head; Vertex != NULL; Vertex = Vertex->PtNext)
+				if ((Edge = OutPosition (Vertex->PtAdj, pv)) != NULL)
+				{
+					UnlinkArc (pdig, Vertex, Edge);
+					pdig->NEdges--;
+				}
 	}
-					/* remoo do vrtice */
+					/* remoção do vértice */
 	if (Delete == pdig->Head)
-	{				/* remoo do vrtice da cabea do dgrafo */
+	{				/* remoção do vértice da cabeça do dígrafo */
 		if (Delete->PtNext != NULL) Delete->PtNext->PtPrev = NULL;
 		pdig->Head = Delete->PtNext;
 	}
 	else
-	{				/* remoo de outro vrtice do dgrafo */
+	{				/* remoção de outro vértice do dígrafo */
 		Delete->PtPrev->PtNext = Delete->PtNext;
 		if (Delete->PtNext != NULL) Delete->PtNext->PtPrev = Delete->PtPrev;
 	}
-	DestroyBiNode (&Delete);	/* destruir bin com vrtice */
-	pdig->NVertexes--;	/* atualizar o nmero de vrtices */
-
-					/* remover as arestas incidentes */
-	Vertex = pdig->Head;	/* vrtice da cabea do dgrafo */
-	while (Vertex != NULL)
-	{				/* remover a aresta deste vrtice para o vrtice removido */
-		if ((Edge = OutPosition (Vertex->PtAdj, pv)) != NULL)
-		{
-			if (Edge == Vertex->PtAdj)
-			{		/* remoo da aresta da cabea da lista das arestas */
-				if (Edge->PtNext != NULL) Edge->PtNext->PtPrev = NULL;
-				Vertex->PtAdj = Vertex->PtAdj->PtNext;
-			}
-			else
-			{		/* remoo de outra aresta da lista das arestas */
-				Edge->PtPrev->PtNext = Edge->PtNext;
-				if (Edge->PtNext != NULL) Edge->PtNext->PtPrev = Edge->PtPrev;
-			}
-			((PtVertex) Vertex->PtElem)->OutDeg--;	/* atualizar semigrau */
-			DestroyBiNode (&Edge);	/* destruir bin com aresta */
-			if (pdig->Type) pdig->NEdges--;	/* atualizar o nmero de arestas */
-		}
-		Vertex = Vertex->PtNext;	/* vrtice seguinte do dgrafo */
+	DestroyBiNode (pdig, &Delete);	/* destruir binó com vértice */
+	pdig->Index[pv] = NULL;	/* retirar o vértice da tabela de acesso direto */
+	if (pdig->Present != NULL)
+	{
+		BIT_CLEAR (pdig->Present, pv);
+		if (pdig->Present[pv / WORD_BITS] == 0) BIT_CLEAR (pdig->Present + BIT_WORDS (pdig->IndexSize), pv / WORD_BITS);
 	}
+	pdig->NVertexes--;	/* atualizar o número de vértices */
+
 	return OK;
 }
 
 int InEdge (PtDigraph pdig, unsigned int pv1, unsigned int pv2, int pcost)
 {
-	PtBiNode V1, V2;	/* posio dos vrtices adjacentes */
+	PtBiNode V1, V2;	/* posição dos vértices adjacentes */
+	unsigned int Valid;
 
 	if (pdig == NULL) return NO_DIGRAPH;
-	if (pdig->NVertexes == 0) return NO_VERTEX;	/* sem vrtices */
+	if (pdig->NVertexes == 0) return NO_VERTEX;	/* sem vértices */
 	if (pv1 == pv2) return REP_EDGE;	/* lacetes proibidos */
 
-			/* verificar se os vrtices existem e se a aresta j existe */
-	if ((V1 = OutPosition (pdig->Head, pv1)) == NULL)
-		return NO_VERTEX;	/* vrtice emergente inexistente */
+			/* verificar se os vértices existem e se a aresta já existe */
+	if ((V1 = VertexPosition (pdig, pv1)) == NULL)
+		return NO_VERTEX;	/* vértice emergente inexistente */
 	if (V1->PtAdj != NULL && OutPosition (V1->PtAdj, pv2) != NULL)
 		return REP_EDGE;	/* aresta existente */
-	if ((V2 = OutPosition (pdig->Head, pv2)) == NULL)
-		return NO_VERTEX;	/* vrtice incidente inexistente */
+	if ((V2 = VertexPosition (pdig, pv2)) == NULL)
+		return NO_VERTEX;	/* vértice incidente inexistente */
+
+					/* tornar próprias as listas partilhadas com cópias */
+	if (OwnList (pdig, V1) != OK || (!pdig->Type && OwnList (pdig, V2) != OK)) return NO_MEM;
 
 					/* inserir a aresta v1-v2 */
-	if (InsertEdge (V1, V2, pcost) != OK) return NO_MEM;
-	if (!pdig->Type)	/* se  grafo, inserir tambm a aresta v2-v1 */
-		if (InsertEdge (V2, V1, pcost) != OK)
-		{		/* se a aresta v2-v1 no foi inserida, remover a aresta v1-v2 */
-			DeleteEdge (V1, V2); return NO_MEM;
+	Valid = PartitionValid (pdig);
+	if (InsertEdge (pdig, V1, V2, pcost) != OK) return NO_MEM;
+	if (!pdig->Type)	/* se é grafo, inserir também a aresta v2-v1 */
+		if (InsertEdge (pdig, V2, V1, pcost) != OK)
+		{		/* se a aresta v2-v1 não foi inserida, remover a aresta v1-v2 */
+			DeleteEdge (pdig, V1, V2); return NO_MEM;
 		}
 
-	pdig->NEdges++;	/* incrementar o nmero de arestas */
+	pdig->NEdges++;	/* incrementar o número de arestas */
+
+	if (Valid)
+	{				/* juntar as componentes dos dois vértices */
+		UnionSets (pdig->Parent, pdig->Rank, pv1, pv2);
+		pdig->PartitionVersion = pdig->Version;
+	}
 	return OK;
 }
 
 int OutEdge (PtDigraph pdig, unsigned int pv1, unsigned int pv2)
 {
-	PtBiNode V1, V2;	/* posio dos vrtices adjacentes */
+	PtBiNode V1, V2;	/* posição dos vértices adjacentes */
 
 	if (pdig == NULL) return NO_DIGRAPH;
 	if (pdig->NVertexes == 0) return NO_VERTEX;
 	if (pdig->NEdges == 0 || pv1 == pv2) return NO_EDGE;
 
-			/* verificar se os vrtices e a aresta existem */
-	if ((V1 = OutPosition (pdig->Head, pv1)) == NULL)
-		return NO_VERTEX;	/* vrtice emergente inexistente */
+			/* verificar se os vértices e a aresta existem */
+	if ((V1 = VertexPosition (pdig, pv1)) == NULL)
+		return NO_VERTEX;	/* vértice emergente inexistente */
 	if (V1->PtAdj == NULL || OutPosition (V1->PtAdj, pv2) == NULL)
 		return NO_EDGE;	/* aresta inexistente */
-	if ((V2 = OutPosition (pdig->Head, pv2)) == NULL)
-		return NO_VERTEX;	/* vrtice incidente inexistente */
+	if ((V2 = VertexPosition (pdig, pv2)) == NULL)
+		return NO_VERTEX;	/* vértice incidente inexistente */
 
+					/* tornar próprias as listas partilhadas com cópias */
+	if (OwnList (pdig, V1) != OK || (!pdig->Type && OwnList (pdig, V2) != OK)) return NO_MEM;
  
-	DeleteEdge (V1, V2);	/* remover a aresta v1-v2 */
-					/* se  grafo, remover tambm a aresta v2-v1 */
-	if (!pdig->Type) DeleteEdge (V2, V1);
+	DeleteEdge (pdig, V1, V2);	/* remover a aresta v1-v2 */
+					/* se é grafo, remover também a aresta v2-v1 */
+	if (!pdig->Type) DeleteEdge (pdig, V2, V1);
+
+	pdig->NEdges--;	/* decrementar o número de arestas */
+	return OK;
+}
+
+int DigraphApplyBatch (PtDigraph pdig, EDGEOP pops[], unsigned int pn)
+{
+	struct batcharc *Arcs; PtBiNode V = NULL, Prev = NULL, Cur = NULL;
+	unsigned int NArcs = 0, NInserts = 0, I, A, Exists; int Linked = 0;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pops == NULL) return NULL_PTR;
+	if (pn == 0) return OK;
+
+		/* num grafo, cada operação altera os arcos dos dois sentidos */
+	if ((Arcs = (struct batcharc *) malloc ((pdig->Type ? pn : 2 * pn) * sizeof (struct batcharc))) == NULL) return NO_MEM;
+
+	for (I = 0; I < pn; I++)
+	{		/* validar as operações como InEdge e OutEdge */
+		if (pdig->NVertexes == 0) pops[I].Status = NO_VERTEX;
+		else if (pops[I].V1 == pops[I].V2) pops[I].Status = pops[I].Op == EDGE_INSERT ? REP_EDGE : NO_EDGE;
+		else if (VertexPosition (pdig, pops[I].V1) == NULL) pops[I].Status = NO_VERTEX;
+		else if (VertexPosition (pdig, pops[I].V2) == NULL) pops[I].Status = pops[I].Op == EDGE_INSERT ? NO_VERTEX : NO_EDGE;
+		else
+		{
+			pops[I].Status = OK;
+			Arcs[NArcs].V1 = pops[I].V1; Arcs[NArcs].V2 = pops[I].V2; Arcs[NArcs++].Op = I;
+			if (!pdig->Type) { Arcs[NArcs].V1 = pops[I].V2; Arcs[NArcs].V2 = pops[I].V1; Arcs[NArcs++].Op = I; }
+			if (pops[I].Op == EDGE_INSERT) NInserts++;
+		}
+	}
+
+		/* agrupar por vértice emergente e incidente, mantendo a ordem das operações */
+	if (SortBatchArcs (pdig, Arcs, NArcs) != OK) { free (Arcs); return NO_MEM; }
+
+		/* tornar próprias as listas partilhadas com cópias que o lote altera */
+	for (A = 0; A < NArcs; A++)
+		if ((A == 0 || Arcs[A].V1 != Arcs[A-1].V1) && OwnList (pdig, pdig->Index[Arcs[A].V1]) != OK)
+		{ free (Arcs); return NO_MEM; }
+
+		/* reservar todos os binós que as inserções podem precisar */
+	if (ReserveNodes (pdig, pdig->Type && !pdig->Incoming ? NInserts : 2 * NInserts) != OK)
+	{ free (Arcs); return NO_MEM; }
+
+	for (A = 0; A < NArcs; A++)
+	{
+		if (A == 0 || Arcs[A].V1 != Arcs[A-1].V1)
+		{ V = pdig->Index[Arcs[A].V1]; Prev = NULL; Cur = V->PtAdj; }
+
+		if (A == 0 || Arcs[A].V1 != Arcs[A-1].V1 || Arcs[A].V2 != Arcs[A-1].V2)
+			while (Cur != NULL && Cur->Number < Arcs[A].V2) { Prev = Cur; Cur = Cur->PtNext; }	/* avançar na fusão */
+
+		I = Arcs[A].Op; Exists = Cur != NULL && Cur->Number == Arcs[A].V2;
+		if (pops[I].Op == EDGE_INSERT)
+		{
+			if (Exists) pops[I].Status = REP_EDGE;
+			else
+			{
+				LinkEdge (pdig, V, Prev, pdig->Index[Arcs[A].V2], pops[I].Cost);
+				Cur = Prev == NULL ? V->PtAdj : Prev->PtNext;
+				pops[I].Status = OK; Linked++;
+			}
+		}
+		else
+		{
+			if (!Exists) pops[I].Status = NO_EDGE;
+			else
+			{
+				UnlinkArc (pdig, V, Cur);
+				Cur = Prev == NULL ? V->PtAdj : Prev->PtNext;
+				pops[I].Status = OK; Linked--;
+			}
+		}
+	}
 
-	pdig->NEdges--;	/* decrementar o nmero de arestas */
+	pdig->NEdges += pdig->Type ? Linked : Linked / 2;	/* num grafo, uma aresta por cada dois arcos */
+	free (Arcs);
 	return OK;
 }
 
@@ -298,7 +726,7 @@ int EdgeNumber (PtDigraph pdig, unsigned int *pne)
 
 int GetVertexList (PtDigraph pdig, unsigned int ppos, char *pvlist)
 {
-	PtBiNode PVert, PEdge; PtEdge Edge; char NodeList[20];
+	PtBiNode PVert, PEdge; PtEdge Edge;
 
 	if (pdig == NULL) return NO_DIGRAPH;
 	if (ppos > pdig->NVertexes) return NO_VERTEX;
@@ -307,93 +735,222 @@ int GetVertexList (PtDigraph pdig, unsigned int ppos, char *pvlist)
 	ppos--;
 	for (PVert = pdig->Head; ppos > 0; ppos--) PVert = PVert->PtNext;
 
-	sprintf (NodeList, "Vertice %2d > ", PVert->Number);
-	strcpy (pvlist, NodeList);
+	/* escrita no fim da sequência, sem a voltar a percorrer */
+	pvlist += sprintf (pvlist, "Vertice %2d > ", PVert->Number);
 
 	for (PEdge = PVert->PtAdj; PEdge != NULL; PEdge = PEdge->PtNext)
 	{
-		sprintf (NodeList, "%2d (", PEdge->Number);
-		strcat (pvlist, NodeList);
-		Edge = (PtEdge) PEdge->PtElem;
-		sprintf (NodeList, "%2d) ", Edge->Cost);
-		strcat (pvlist, NodeList);
+		Edge = &PEdge->Elem.Edge;
+		pvlist += sprintf (pvlist, "%2d (%2d) ", PEdge->Number, Edge->Cost);
 	}
 
 	return OK;
 }
 
+int DigraphVertexBegin (PtDigraph pdig, DIGRAPHCURSOR *pcur)
+{
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pcur == NULL) return NULL_PTR;
+
+	pcur->Node = pdig->Head;	/* primeiro vértice da lista */
+	return OK;
+}
+
+int DigraphVertexNext (DIGRAPHCURSOR *pcur, unsigned int *pv, unsigned int *pindeg, unsigned int *poutdeg)
+{
+	PtBiNode Vert;
+
+	if (pcur == NULL || pv == NULL) return NULL_PTR;
+	if ((Vert = (PtBiNode) pcur->Node) == NULL) return NO_VERTEX;	/* fim da lista */
+
+	*pv = Vert->Number;
+	if (pindeg != NULL) *pindeg = Vert->Elem.Vertex.InDeg;
+	if (poutdeg != NULL) *poutdeg = Vert->Elem.Vertex.OutDeg;
+	pcur->Node = Vert->PtNext;	/* avançar para o vértice seguinte */
+	return OK;
+}
+
+int DigraphEdgeBegin (PtDigraph pdig, unsigned int pv, DIGRAPHCURSOR *pcur)
+{
+	PtBiNode Vert;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pcur == NULL) return NULL_PTR;
+	if ((Vert = VertexPosition (pdig, pv)) == NULL) return NO_VERTEX;
+
+	pcur->Node = Vert->PtAdj;	/* primeira aresta da lista de adjacências */
+	return OK;
+}
+
+int DigraphEdgeNext (DIGRAPHCURSOR *pcur, unsigned int *pv2, int *pcost)
+{
+	PtBiNode PEdge;
+
+	if (pcur == NULL || pv2 == NULL) return NULL_PTR;
+	if ((PEdge = (PtBiNode) pcur->Node) == NULL) return NO_EDGE;	/* fim da lista */
+
+	*pv2 = PEdge->Number;
+	if (pcost != NULL) *pcost = PEdge->Elem.Edge.Cost;
+	pcur->Node = PEdge->PtNext;	/* avançar para a aresta seguinte */
+	return OK;
+}
+
 PtDigraph CreateFile (char *pfilename)
 {
-  PtDigraph Digraph; FILE *PtF;
-  unsigned int Type, NVertexes, NEdges, V, E, Vert1, Vert2; int Status, Cost;
+  PtDigraph Digraph; FILE *PtF; struct arc *Arcs;
+  char *Buffer, *Pos, *End; long Size, Value[3];
+  unsigned int Type, NVertexes, NEdges, V, E, NArcs = 0;
 
-  /* abertura com validao do ficheiro para leitura */
+  /* abertura com validação do ficheiro para leitura */
   if ( (PtF = fopen (pfilename, "r")) == NULL) return NULL;
 
-  /* leitura do tipo de digrafo/grafo e criao do vazio */
-  fscanf (PtF, "%d", &Type); fscanf (PtF, "%*c");
+  /* leitura do ficheiro completo para memória */
+  fseek (PtF, 0L, SEEK_END); Size = ftell (PtF); rewind (PtF);
+  if (Size < 0 || (Buffer = (char *) malloc (Size + 1)) == NULL) { fclose (PtF); return NULL; }
+  Size = (long) fread (Buffer, 1, Size, PtF);
+  fclose (PtF);  /* fecho do ficheiro */
+  Pos = Buffer; End = Buffer + Size;
 
-  /* leitura do nmero de vrtices e de arestas do ficheiro e criao do digrafo vazio */
-  fscanf (PtF, "%d %d", &NVertexes, &NEdges); fscanf (PtF, "%*c");
+  /* leitura do tipo de digrafo/grafo e do número de vértices e de arestas */
+  if (!ParseNumber (&Pos, End, &Value[0]) || !ParseNumber (&Pos, End, &Value[1]) || !ParseNumber (&Pos, End, &Value[2]))
+  { free (Buffer); return NULL; }
+  /* cada aresta ocupa pelo menos 6 carateres ("a b c\n"), o que limita NEdges ao que o ficheiro pode conter */
+  if (Value[0] < 0 || Value[0] > UINT_MAX || Value[1] < 0 || Value[1] > UINT_MAX || Value[2] < 0 || Value[2] > Size / 6)
+  { free (Buffer); return NULL; }
+  Type = (unsigned int) Value[0]; NVertexes = (unsigned int) Value[1]; NEdges = (unsigned int) Value[2];
 
-  if ((Digraph = Create (Type)) == NULL) { fclose (PtF); return NULL; }
+  if ((Digraph = Create (Type)) == NULL) { free (Buffer); return NULL; }
 
-  /* leitura dos vrtices do ficheiro */
+  /* leitura dos vértices */
   for (V = 0; V < NVertexes ; V++)
-    {
-      fscanf (PtF, "%d", &Vert1); fscanf (PtF, "%*c");
-      if (InVertex (Digraph, Vert1))
-      { Destroy (&Digraph); fclose (PtF); return NULL; }
-    }
+    if (!ParseNumber (&Pos, End, &Value[0]) || Value[0] < 0 || Value[0] >= UINT_MAX || InVertex (Digraph, (unsigned int) Value[0]))
+    { Destroy (&Digraph); free (Buffer); return NULL; }
+
+  /* leitura das arestas para uma sequência de arcos (nos dois sentidos, se for grafo) */
+  if ((Arcs = (struct arc *) malloc ((Type ? 1 : 2) * ((size_t) NEdges + 1) * sizeof (struct arc))) == NULL)
+  { Destroy (&Digraph); free (Buffer); return NULL; }
 
-  /* leitura das arestas do ficheiro */
   for (E = 0; E < NEdges ; E++)
     {
-      Status = fscanf (PtF, "%d %d %d", &Vert1, &Vert2, &Cost); fscanf (PtF, "%*c");
-      if (Status != 3)
-      { Destroy (&Digraph); fclose (PtF); return NULL; }
+      if (!ParseNumber (&Pos, End, &Value[0]) || !ParseNumber (&Pos, End, &Value[1]) || !ParseNumber (&Pos, End, &Value[2])
+          || Value[0] < 0 || Value[0] >= UINT_MAX || Value[1] < 0 || Value[1] >= UINT_MAX || Value[2] < INT_MIN || Value[2] > INT_MAX)
+      { Destroy (&Digraph); free (Arcs); free (Buffer); return NULL; }
 
-      if (InEdge (Digraph, Vert1, Vert2, Cost))
-      { Destroy (&Digraph); fclose (PtF); return NULL; }
+      Arcs[NArcs].V1 = (unsigned int) Value[0]; Arcs[NArcs].V2 = (unsigned int) Value[1]; Arcs[NArcs++].Cost = (int) Value[2];
+      if (!Type)
+      { Arcs[NArcs].V1 = (unsigned int) Value[1]; Arcs[NArcs].V2 = (unsigned int) Value[0]; Arcs[NArcs++].Cost = (int) Value[2]; }
     }
+  free (Buffer);
 
-  fclose (PtF);  /* fecho do ficheiro */
+  /* construção de todas as listas de adjacências numa só passagem */
+  if (BulkInsertEdges (Digraph, Arcs, NArcs) != OK) Destroy (&Digraph);
 
+  free (Arcs);
   return Digraph;  /* devolve o digrafo criado */
 }
 
+PtDigraph CreateStream (FILE *pstream, unsigned int ptype)
+{
+	PtDigraph Digraph; char *Chunk, *Pos, *End, *Line;
+	size_t Kept = 0, Read; int Error = OK;
+
+	if (pstream == NULL) return NULL;
+	if ((Digraph = Create (ptype)) == NULL) return NULL;
+
+	/* o bloco de leitura tem dimensão fixa, seja qual for o tamanho do fluxo */
+	if ((Chunk = (char *) malloc (STREAM_CHUNK + 1)) == NULL) { Destroy (&Digraph); return NULL; }
+
+	do
+	{
+		Read = fread (Chunk + Kept, 1, STREAM_CHUNK - Kept, pstream);
+		End = Chunk + Kept + Read;
+		if (Read == 0 && Kept > 0) *End++ = '\n';	/* última linha sem fim de linha */
+
+		/* processamento das linhas completas do bloco */
+		for (Pos = Chunk; Error == OK && (Line = (char *) memchr (Pos, '\n', End - Pos)) != NULL; Pos = Line + 1)
+			Error = StreamRecord (Digraph, Pos, Line);
+
+		/* a linha incompleta passa para o início do bloco seguinte */
+		Kept = End - Pos;
+		if (Kept == STREAM_CHUNK) Error = NO_FILE;	/* linha maior do que o bloco */
+		memmove (Chunk, Pos, Kept);
+	} while (Error == OK && Read > 0);
+
+	free (Chunk);
+	if (Error == OK && ferror (pstream)) Error = NO_FILE;
+
+	/* ordenação das listas de adjacências e ligação da lista de vértices */
+	if (Error != OK || StreamFinish (Digraph) != OK) Destroy (&Digraph);
+
+	return Digraph;  /* devolve o digrafo criado */
+}
+
 int StoreFile (PtDigraph pdig, char *pfilename)
 {
   FILE *PtF; PtBiNode Vert, PEdge; PtEdge Edge;
 
   if (pdig == NULL) return NO_DIGRAPH;
 
-  /* abertura com validao do ficheiro para escrita */
+  /* abertura com validação do ficheiro para escrita */
   if ((PtF = fopen (pfilename, "w")) == NULL) return NO_FILE;
 
-  /* escrita do nmero de vrtices e de arestas do digrafo no ficheiro */
-  fprintf (PtF, "%u %u\n", pdig->NVertexes, pdig->NEdges);
+  /* escrita do tipo e do número de vértices e de arestas do digrafo no ficheiro */
+  fprintf (PtF, "%u\n%u %u\n", pdig->Type, pdig->NVertexes, pdig->NEdges);
 
-  /* escrita dos vrtices do digrafo no ficheiro */
+  /* escrita dos vértices do digrafo no ficheiro */
   for (Vert = pdig->Head; Vert != NULL; Vert = Vert->PtNext)
     fprintf (PtF, "%d\n", Vert->Number);
 
   /* escrita das arestas do digrafo no ficheiro */
   for (Vert = pdig->Head; Vert != NULL; Vert = Vert->PtNext)
     for (PEdge = Vert->PtAdj; PEdge != NULL; PEdge = PEdge->PtNext)
-    {
-      Edge = (PtEdge) PEdge->PtElem;
-      fprintf (PtF, "%d %d %d\n", Vert->Number, PEdge->Number, Edge->Cost);
-    }
+      if (pdig->Type || Vert->Number < PEdge->Number)	/* num grafo, cada aresta uma só vez */
+      {
+        Edge = &PEdge->Elem.Edge;
+        fprintf (PtF, "%d %d %d\n", Vert->Number, PEdge->Number, Edge->Cost);
+      }
 
   fclose (PtF);  /* fecho do ficheiro */
 
   return OK;
 }
 
+/************************** Contexto de Consulta ***************************/
+
+PtQuery QueryCreate (PtDigraph pdig)
+{
+	PtQuery Query;
+
+	if (pdig == NULL) return NULL;
+
+	if ((Query = (PtQuery) calloc (1, sizeof (struct query))) == NULL) return NULL;
+	if (QueryBegin (Query, pdig, 1, pdig->PQueueKind) != OK) QueryDestroy (&Query);
+	return Query;	/* devolve o contexto criado */
+}
+
+int QueryDestroy (PtQuery *pquery)
+{
+	PtQuery TmpQuery = *pquery; unsigned int S;
+
+	if (TmpQuery == NULL) return NULL_PTR;
+
+	for (S = 0; S < 2; S++)
+	{
+		free (TmpQuery->Side[S].Mark);
+		free (TmpQuery->Side[S].Pred);
+		free (TmpQuery->Side[S].Cost);
+		if (TmpQuery->Side[S].PQueue != NULL) PQueueDestroy (&TmpQuery->Side[S].PQueue);
+	}
+	free (TmpQuery->Frontier);
+	free (TmpQuery);
+	*pquery = NULL;	/* colocar a referência do contexto a NULL */
+
+	return OK;
+}
+
 /********************** Aulas 13 e 14 e Trabalho Final  **********************/
 
-int VertexType (PtDigraph pdig, unsigned int pv)
+int VertexType (PtDigraph pdig, unsigned int pv, PtQuery pquery)
 { 
 
 	PtBiNode Node;
@@ -406,12 +963,12 @@ int VertexType (PtDigraph pdig, unsigned int pv)
     	/* Verifica se o digrafo esta vazio */
     	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
 
-    	/* Verifica se o vrtice de partida existe */
-    	if ((Node = OutPosition(pdig->Head, pv)) == NULL) return NO_VERTEX;
+    	/* Verifica se o vértice de partida existe */
+    	if ((Node = VertexPosition (pdig, pv)) == NULL) return NO_VERTEX;
 
-    	Vertex = Node->PtElem;
+    	Vertex = &Node->Elem.Vertex;
 	
-	flag |= (Vertex->OutDeg != 0) << 1;  /* Arcos de sada */	
+	flag |= (Vertex->OutDeg != 0) << 1;  /* Arcos de saída */	
 	flag |= (Vertex->InDeg != 0);	     /* Arcos de entrada */
 
     	switch(flag){
@@ -428,7 +985,7 @@ int VertexType (PtDigraph pdig, unsigned int pv)
 
 }
 
-int Dijkstra (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[])
+int Dijkstra (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[], PtQuery pquery)
 { 
 
 	PtBiNode aux;
@@ -439,393 +996,2754 @@ int Dijkstra (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost
 	/* verificar se o digrafo esta vazio */
 	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
 
-	/* verificar se o ponteiro para a lista  nulo */
-    	if ((pdig->Head->PtElem) == NULL) return NULL_PTR;
+	/* verificar se os ponteiros para as sequências são nulos */
+    	if (pvpred == NULL || pvcost == NULL) return NULL_PTR;
 	
-	/* verificar se o vrtice de partida existe */
-	if ((aux = OutPosition (pdig->Head, pv)) == NULL) return NO_VERTEX;
+	/* verificar se o vértice de partida existe */
+	if ((aux = VertexPosition (pdig, pv)) == NULL) return NO_VERTEX;
 	
-	DijkstraPQueue (pdig, pv, pvpred, pvcost);
-	
-	return OK;
+	return DijkstraPQueue (pdig, pv, pvpred, pvcost, pquery);
 
 }
 
-int Reach (PtDigraph pdig, unsigned int pv, unsigned int pvlist[])
-{ 
-
-	PtBiNode aux;
-	unsigned int *pvpred;
-    	unsigned int i, count = 1;
-    	int *pcost;
-     
-    	/* Verifica se o digrafo existe */
-    	if (pdig == NULL) return NO_DIGRAPH;
-     
-    	/* Verifica se o digrafo est vazio */
-    	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
-     
-    	/* Verifica se o ponteiro para a lista  nulo */
-    	if ((pdig->Head->PtElem) == NULL) return NULL_PTR;
-     
-    	/* Verifica se o vrtice de partida existe */
-	if ((aux = OutPosition (pdig->Head, pv)) == NULL) return NO_VERTEX;
+int BellmanFord (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[], PtQuery pquery)
+{
+	PtBiNode V; PtQuery Query = pquery; int Error;
 
-	if (pvlist == NULL) return NO_MEM;
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pvpred == NULL || pvcost == NULL) return NULL_PTR;
+	if ((V = VertexPosition (pdig, pv)) == NULL) return NO_VERTEX;
 
-    	/* Verifica se no existe memria para criar as sequncias necessrias para invocar o algoritmo de Dijkstra */
-    	if ((pvpred = (unsigned int *) malloc ((pdig->NVertexes) * (sizeof(unsigned int)))) == NULL) return NO_MEM;
-    	if ((pcost = (int *) malloc (pdig->NVertexes * (sizeof(int)))) == NULL) return NO_MEM;
+				/* preparar o contexto; o segundo sentido guarda a fila e os comprimentos */
+	if (Query == NULL && (Query = QueryCreate (pdig)) == NULL) return NO_MEM;
+	if ((Error = QueryBegin (Query, pdig, 2, pdig->PQueueKind)) == OK && (Error = SPFASearch (pdig, V, Query)) == OK)
+		DijkstraResult (pdig, Query, pvpred, pvcost);
 
-    	/* Invocao do algoritmo de Dijkstra */
-    	DijkstraPQueue(pdig, pv, pvpred, pcost);
- 
-    	/* Verifica se todos os vrtices so alcanveis pelo pv */
-	/* Preenchimento das restantes posies do pvlist com o nmero dos vrtices alcanveis por pv */
-	for (i = 1; i < pdig->NVertexes; i++)
-		if (pvpred[i-1] != 0)
-			pvlist[count++] = i;
-	
-	/* Primeira posio do pvlist guarda o nmero de vrtices alcanveis por pv */
-	pvlist[0] = count-1;
+	if (Query != pquery) QueryDestroy (&Query);
+	return Error;
+}
 
-	free (pvpred);
-	free (pcost);
-	
-	pvpred = NULL;
-	pcost = NULL;
+int ShortestPaths (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[], PtQuery pquery)
+{
+	int Error;
 
-    	return OK;
+	if (pdig == NULL) return NO_DIGRAPH;
 
+	if (pdig->NNegative == 0) return Dijkstra (pdig, pv, pvpred, pvcost, pquery);
+				/* custos negativos: num dígrafo acíclico basta a ordem topológica */
+	if (pdig->Type && (Error = DAGPaths (pdig, pv, pvpred, pvcost, 0)) != NO_DAG) return Error;
+	return BellmanFord (pdig, pv, pvpred, pvcost, pquery);
 }
 
-int DigraphRegular (PtDigraph pdig, unsigned int *preg)
+int DigraphTopologicalSort (PtDigraph pdig, unsigned int porder[])
 {
+	unsigned int *Order; int Error;
 
-	PtBiNode temp = pdig->Head;
-	PtVertex Vertex = temp->PtElem;
-	unsigned int degree = Vertex->InDeg;
-
-	/* Verifica se o digrafo existe */
-    	if (pdig == NULL) return NO_DIGRAPH;
-     
-    	/* Verifica se o digrafo est vazio */
-     	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (porder == NULL) return NULL_PTR;
 
-    	/* Verifica se o ponteiro para a lista  nulo */
-    	if ((pdig->Head->PtElem) == NULL) return NULL_PTR;
- 
-	/* Verifica se todos os vrtices tm o mesmo grau */
-	do{
-		Vertex = temp->PtElem;
-		if((Vertex->InDeg != Vertex->OutDeg) && (Vertex->InDeg != degree)){
-			*preg = 0;
-			return OK;
-		}
-		temp = temp->PtNext;
-	}while(temp != NULL);
+	if ((Error = TopologicalOrder (pdig, &Order)) != OK) return Error;
 
-	*preg = 1; 
+	porder[0] = pdig->NVertexes;
+	memcpy (porder + 1, Order, pdig->NVertexes * sizeof (unsigned int));
 	return OK;
+}
 
+int DigraphDAGShortest (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[])
+{
+	return DAGPaths (pdig, pv, pvpred, pvcost, 0);
 }
 
-PtDigraph DigraphComplement (PtDigraph pdig)
+int DigraphDAGLongest (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[])
 {
+	return DAGPaths (pdig, pv, pvpred, pvcost, 1);
+}
 
-	PtBiNode Node, V1, V2;
-	PtDigraph pdigij;
-	unsigned int *pvlist;
+int DigraphSetPQueue (PtDigraph pdig, unsigned int pkind)
+{
+	if (pdig == NULL) return NO_DIGRAPH;
 
-	/* Verifica se o digrafo existe */
-	if (pdig == NULL) return NULL;
-	
-	/* Verifica se o ponteiro para a lista  nulo */
-	if ((pdig->Head->PtElem) == NULL) return NULL;
-	
-	/* Verifica se existe memria no digrafo */
-    	if ((pvlist = (unsigned int *) malloc(pdig->NVertexes * sizeof(unsigned int))) == NULL) return NULL;	
-	
-	/* Cria um digrafo nulo */
-	pdigij = Create(pdig->Type);
+	pdig->PQueueKind = pkind == DIJKSTRA_RADIX ? PQUEUE_RADIX : PQUEUE_BINARY;
+	return OK;
+}
 
-	/* Cria o digrafo complementar, inserindo os vrtices e as arestas */
-	for (Node = pdig->Head; Node != NULL; Node = Node->PtNext)
-		if(InVertex(pdigij, Node->Number) != 0)	return NULL;
+int DigraphSetIncoming (PtDigraph pdig, unsigned int pon)
+{
+	PtBiNode V, E, Twin;
 
-	for (V1 = pdig->Head; V1 != NULL; V1 = V1->PtNext){		
-		for (V2 = pdig->Head; V2 != NULL; V2 = V2->PtNext){					
-			if ((V1->Number != V2->Number) && (V1->PtAdj == NULL || OutPosition(V1->PtAdj, V2->Number) == NULL)) 
-				InEdge(pdigij, V1->Number, V2->Number, 1);
-		}
+	if (pdig == NULL) return NO_DIGRAPH;
+
+	pon = pon != 0;
+	if (pdig->Incoming == pon) return OK;
+	if (pon && pdig->Type)	/* os gémeos alteram os arcos, que deixam de poder ser partilhados */
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+			if (OwnList (pdig, V) != OK) return NO_MEM;
+	pdig->Incoming = pon;
+	if (!pdig->Type) return OK;	/* num grafo, as listas de adjacências já são simétricas */
+
+	if (pon)
+	{		/* construir as listas com um gémeo por arco */
+		if (ReserveNodes (pdig, pdig->NEdges) != OK) { pdig->Incoming = 0; return NO_MEM; }
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+			for (E = V->PtAdj; E != NULL; E = E->PtNext)
+			{
+				Twin = CreateBiNode (pdig, V->Number);
+				LinkIncoming (V, E, Twin);
+			}
 	}
+	else	/* destruir as listas, desligando os gémeos */
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+			while ((Twin = V->Elem.Vertex.PtIn) != NULL)
+			{
+				V->Elem.Vertex.PtIn = Twin->PtNext;
+				Twin->Elem.Edge.PtTwin->Elem.Edge.PtTwin = NULL;
+				DestroyBiNode (pdig, &Twin);
+			}
 
-	free(pvlist);
-	return pdigij;
+	return OK;
+}
 
- }
+int DigraphSetConnectivity (PtDigraph pdig, unsigned int pon)
+{
+	if (pdig == NULL) return NO_DIGRAPH;
 
-int DigraphStronglyConnected (PtDigraph pdig, unsigned int *pstrong)
-{  
+	pdig->Connectivity = pon != 0;
+	return OK;
+}
 
-	unsigned int *pvlist;
-    	PtBiNode Vt;
+int DigraphAllPairs (PtDigraph pdig, unsigned int pnthreads, unsigned int ppred[], int pcost[])
+{
+	struct allpairs Job; pthread_t *Threads; unsigned int Created = 0, I;
 
-    	/* Verifica se o digrafo existe */
-    	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (ppred == NULL || pcost == NULL) return NULL_PTR;
+
+	if (pnthreads == 0)	/* um fio por processador disponível */
+	{
+		long NProc = sysconf (_SC_NPROCESSORS_ONLN);
+		pnthreads = NProc > 0 ? (unsigned int) NProc : 1;
+	}
+	if (pnthreads > pdig->NVertexes) pnthreads = pdig->NVertexes;
+
+	Job.Digraph = pdig; Job.Next = pdig->Head; Job.Error = OK;
+	for (Job.Dim = pdig->IndexSize - 1; pdig->Index[Job.Dim] == NULL; Job.Dim--) ;	/* maior número de vértice */
+	Job.Pred = ppred; Job.Cost = pcost;
+	if (pthread_mutex_init (&Job.Lock, NULL) != 0) return NO_MEM;
+
+	/* os fios adicionais; o fio que chama também trabalha */
+	if ((Threads = (pthread_t *) malloc (pnthreads * sizeof (pthread_t))) != NULL)
+		for (I = 1; I < pnthreads; I++)
+			if (pthread_create (&Threads[Created], NULL, AllPairsWorker, &Job) == 0) Created++;
+
+	AllPairsWorker (&Job);
+
+	for (I = 0; I < Created; I++) pthread_join (Threads[I], NULL);
+	free (Threads);
+	pthread_mutex_destroy (&Job.Lock);
+
+	/* sem memória em todos os fios, sobram vértices de partida por pesquisar */
+	return Job.Next == NULL ? OK : Job.Error;
+}
+
+int DigraphShortestPath (PtDigraph pdig, unsigned int psrc, unsigned int pdst, unsigned int ppath[], int *pcost, PtHeuristic pheuristic, void *pdata, PtQuery pquery)
+{
+	PtBiNode Source, Target; PtQuery Query = pquery;
+	unsigned int Meet = 0, V, N, I; int Best = INT_MAX, Error;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (ppath == NULL || pcost == NULL) return NULL_PTR;
+	if ((Source = VertexPosition (pdig, psrc)) == NULL || (Target = VertexPosition (pdig, pdst)) == NULL) return NO_VERTEX;
+
+				/* preparar o contexto com um ou dois sentidos de pesquisa; A* reabre
+				   vértices, o que o amontoado radix monótono não admite */
+	if (Query == NULL && (Query = QueryCreate (pdig)) == NULL) return NO_MEM;
+	if (pheuristic == NULL) Error = QueryBegin (Query, pdig, 2, pdig->PQueueKind);
+	else Error = QueryBegin (Query, pdig, 1, PQUEUE_BINARY);
+	if (Error == OK)
+	{
+		if (pheuristic == NULL) Error = BidirectionalSearch (pdig, Source, Target, Query, &Meet, &Best);
+		else if ((Best = AStarSearch (pdig, Source, Target, pheuristic, pdata, Query)) != INT_MAX) Meet = pdst;
+	}
+
+	ppath[0] = 0;
+	if (Error == OK && Best == INT_MAX) Error = NO_PATH;
+	if (Error == OK)
+	{		/* troço direto, de psrc até ao vértice de encontro, escrito de trás para a frente */
+		for (N = 0, V = Meet; V != 0; V = Query->Side[0].Pred[V]) N++;
+		for (I = N, V = Meet; V != 0; V = Query->Side[0].Pred[V]) ppath[I--] = V;
+				/* troço inverso, do vértice de encontro até pdst */
+		for (V = Meet; V != pdst; ) ppath[++N] = V = Query->Side[1].Pred[V];
+		ppath[0] = N; *pcost = Best;
+	}
+
+	if (Query != pquery) QueryDestroy (&Query);
+	return Error;
+}
+
+int Reach (PtDigraph pdig, unsigned int pv, unsigned int pvlist[], PtQuery pquery)
+{ 
+
+	PtBiNode Source, Node;
+	PtQuery Query = pquery;
+	unsigned int Count = 0, Found, I;
+     
+	/* Verifica se o digrafo existe */
+	if (pdig == NULL) return NO_DIGRAPH;
+     
+	/* Verifica se o digrafo está vazio */
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+     
+	/* Verifica se a sequência de resultado existe */
+	if (pvlist == NULL) return NULL_PTR;
+     
+	/* Verifica se o vértice de partida existe */
+	if ((Source = VertexPosition (pdig, pv)) == NULL) return NO_VERTEX;
+
+	/* Contexto da consulta: marcas por época e fronteira da pesquisa */
+	if (Query == NULL) { if ((Query = QueryCreate (pdig)) == NULL) return NO_MEM; }
+	else if (QueryBegin (Query, pdig, 1, pdig->PQueueKind) != OK) return NO_MEM;
+
+	Found = ReachSearch (pdig->Index, Source, Query->Side[0].Mark, Query->Epoch, Query->Frontier);
+
+	/* Preenchimento do pvlist, por ordem crescente, com os vértices alcançáveis por pv */
+	if (Found < pdig->NVertexes / 8)	/* poucos vértices: ordenar a fronteira */
+	{
+		for (I = 1; I < Found; I++) pvlist[++Count] = Query->Frontier[I]->Number;
+		qsort (pvlist + 1, Count, sizeof (unsigned int), CompareNumbers);
+	}
+	else	/* muitos vértices: percorrer a lista ordenada de vértices */
+		for (Node = pdig->Head; Node != NULL; Node = Node->PtNext)
+			if (Node != Source && Query->Side[0].Mark[Node->Number] == Query->Epoch)
+				pvlist[++Count] = Node->Number;
+
+	/* Primeira posição do pvlist guarda o número de vértices alcançáveis por pv */
+	pvlist[0] = Count;
+
+	if (Query != pquery) QueryDestroy (&Query);
+	return OK;
+
+}
+
+int DigraphRegular (PtDigraph pdig, unsigned int *preg)
+{
+
+	PtBiNode temp;
+	PtVertex Vertex;
+	unsigned int degree;
+
+	/* Verifica se o digrafo existe */
+    	if (pdig == NULL) return NO_DIGRAPH;
+     
+    	/* Verifica se o digrafo está vazio */
+     	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+
+    	/* Verifica se o ponteiro para o resultado é nulo */
+    	if (preg == NULL) return NULL_PTR;
+
+	temp = pdig->Head;
+	degree = temp->Elem.Vertex.InDeg;
+ 
+	/* Verifica se todos os vértices têm o mesmo grau */
+	do{
+		Vertex = &temp->Elem.Vertex;
+		if((Vertex->InDeg != Vertex->OutDeg) && (Vertex->InDeg != degree)){
+			*preg = 0;
+			return OK;
+		}
+		temp = temp->PtNext;
+	}while(temp != NULL);
+
+	*preg = 1; 
+	return OK;
+
+}
+
+PtDigraph DigraphComplement (PtDigraph pdig)
+{
+
+	PtBiNode V, C, E, Prev, *Vertexes;
+	PtDigraph pdigij;
+	unsigned int *Rank, NArcs = 0, Words, Tail, W, R, B;
+	BITWORD *Row, Word;
+
+	/* Verifica se o digrafo existe */
+	if (pdig == NULL) return NULL;
+
+	/* Conta os arcos do digrafo complementar */
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+		NArcs += pdig->NVertexes - 1 - V->Elem.Vertex.OutDeg;
+
+	/* Cria o digrafo com os mesmos vértices e espaço para todas as arestas */
+	if ((pdigij = CopyVertexes (pdig, NArcs)) == NULL) return NULL;
+	if (pdig->NVertexes == 0) return pdigij;
+
+	/* Posição de cada vértice na lista de vértices, vértices do complementar por posição e linha de vizinhos */
+	Words = BIT_WORDS (pdig->NVertexes); Tail = pdig->NVertexes % WORD_BITS;
+	Rank = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int));
+	Vertexes = (PtBiNode *) malloc (pdig->NVertexes * sizeof (PtBiNode));
+	Row = (BITWORD *) calloc (Words, sizeof (BITWORD));
+	if (Rank == NULL || Vertexes == NULL || Row == NULL)
+	{ free (Rank); free (Vertexes); free (Row); Destroy (&pdigij); return NULL; }
+
+	for (V = pdig->Head, C = pdigij->Head, R = 0; V != NULL; V = V->PtNext, C = C->PtNext, R++)
+	{ Rank[V->Number] = R; Vertexes[R] = C; }
+
+	for (V = pdig->Head, C = pdigij->Head, R = 0; V != NULL; V = V->PtNext, C = C->PtNext, R++)
+	{
+		/* Marca os vizinhos do vértice e o próprio vértice (lacetes proibidos) */
+		BIT_SET (Row, R);
+		for (E = V->PtAdj; E != NULL; E = E->PtNext) BIT_SET (Row, Rank[E->Number]);
+
+		/* Inverte a linha palavra a palavra e acrescenta os arcos ao fim da lista, já ordenada pela posição */
+		for (W = 0, Prev = NULL; W < Words; W++)
+		{
+			Word = ~Row[W]; Row[W] = 0;
+			if (W == Words - 1 && Tail != 0) Word &= (1UL << Tail) - 1;	/* bits para lá do último vértice */
+
+			for (B = W * WORD_BITS; Word != 0; Word >>= 1, B++)
+			{
+				if (!(Word & 1UL)) continue;
+				LinkEdge (pdigij, C, Prev, Vertexes[B], 1);
+				Prev = Prev == NULL ? C->PtAdj : Prev->PtNext;	/* a nova aresta */
+			}
+		}
+	}
+
+	pdigij->NEdges = pdig->Type ? NArcs : NArcs / 2;
+	free (Rank); free (Vertexes); free (Row);
+	return pdigij;
+
+ }
+
+int DigraphStronglyConnected (PtDigraph pdig, unsigned int *pstrong)
+{  
+
+	unsigned int *Comp, NComp;
+	int Error;
+
+	/* Verifica se o digrafo existe */
+	if (pdig == NULL) return NO_DIGRAPH;
+
+	/* Verifica se o digrafo está vazio */
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+
+	/* Verifica se o ponteiro para o resultado é nulo */
+	if (pstrong == NULL) return NULL_PTR;
+
+	if ((Comp = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int))) == NULL) return NO_MEM;
+
+	/* O digrafo é fortemente conexo se tiver uma única componente */
+	if ((Error = DigraphSCC (pdig, Comp, &NComp)) == OK) *pstrong = NComp == 1;
+
+	free (Comp);
+	return Error;
+
+}
+
+int DigraphSCC (PtDigraph pdig, unsigned int comp[], unsigned int *ncomp)
+{
+
+	PtBiNode Root, V, W, *Stack, *CallV, *CallE;
+	unsigned int *Num, *Low, Counter = 0, NComp = 0, Top = 0, Depth = 0;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (comp == NULL || ncomp == NULL) return NULL_PTR;
+
+	/* ordem de descoberta e menor ordem alcançável, indexadas pelo número do vértice */
+	Num = (unsigned int *) calloc (pdig->IndexSize, sizeof (unsigned int));
+	Low = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int));
+	/* pilha de Tarjan e pilha explícita das chamadas (vértice e próxima aresta) */
+	Stack = (PtBiNode *) malloc (pdig->NVertexes * sizeof (PtBiNode));
+	CallV = (PtBiNode *) malloc (pdig->NVertexes * sizeof (PtBiNode));
+	CallE = (PtBiNode *) malloc (pdig->NVertexes * sizeof (PtBiNode));
+	if (Num == NULL || Low == NULL || Stack == NULL || CallV == NULL || CallE == NULL)
+	{ free (Num); free (Low); free (Stack); free (CallV); free (CallE); return NO_MEM; }
+
+	/* a componente 0 indica vértice ainda sem componente */
+	for (V = pdig->Head; V != NULL; V = V->PtNext) comp[V->Number-1] = 0;
+
+	for (Root = pdig->Head; Root != NULL; Root = Root->PtNext)
+	{
+		if (Num[Root->Number]) continue;	/* vértice já visitado */
+
+		Num[Root->Number] = Low[Root->Number] = ++Counter;
+		Stack[Top++] = Root; CallV[Depth] = Root; CallE[Depth++] = Root->PtAdj;
+
+		while (Depth > 0)
+		{
+			V = CallV[Depth-1];
+			if (CallE[Depth-1] != NULL)
+			{	/* processar a próxima aresta do vértice V */
+				W = pdig->Index[CallE[Depth-1]->Number];
+				CallE[Depth-1] = CallE[Depth-1]->PtNext;
+
+				if (!Num[W->Number])
+				{	/* "chamada" para o vértice W ainda não visitado */
+					Num[W->Number] = Low[W->Number] = ++Counter;
+					Stack[Top++] = W; CallV[Depth] = W; CallE[Depth++] = W->PtAdj;
+				}	/* W visitado e sem componente está na pilha de Tarjan */
+				else if (!comp[W->Number-1] && Num[W->Number] < Low[V->Number])
+					Low[V->Number] = Num[W->Number];
+			}
+			else
+			{	/* "retorno" do vértice V */
+				Depth--;
+				if (Low[V->Number] == Num[V->Number])
+				{	/* V é a raiz de uma componente: retirá-la da pilha */
+					NComp++;
+					do
+					{
+						W = Stack[--Top];
+						comp[W->Number-1] = NComp;
+					} while (W != V);
+				}
+				if (Depth > 0 && Low[V->Number] < Low[CallV[Depth-1]->Number])
+					Low[CallV[Depth-1]->Number] = Low[V->Number];
+			}
+		}
+	}
+
+	/* as componentes são completadas por ordem topológica inversa */
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+		comp[V->Number-1] = NComp + 1 - comp[V->Number-1];
+	*ncomp = NComp;
+
+	free (Num); free (Low); free (Stack); free (CallV); free (CallE);
+	return OK;
+
+}
+
+int DigraphConnected (PtDigraph pdig, unsigned int pv1, unsigned int pv2, unsigned int *pconn)
+{
+	int Error;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pconn == NULL) return NULL_PTR;
+	if (VertexPosition (pdig, pv1) == NULL || VertexPosition (pdig, pv2) == NULL) return NO_VERTEX;
+
+		/* a procura comprime os caminhos, pelo que também é feita em exclusão mútua */
+	pthread_mutex_lock (&pdig->CacheLock);
+	if ((Error = Partition (pdig)) == OK)
+		*pconn = FindSet (pdig->Parent, pv1) == FindSet (pdig->Parent, pv2);
+	pthread_mutex_unlock (&pdig->CacheLock);
+
+	return Error;
+}
+
+int DigraphComponents (PtDigraph pdig, unsigned int comp[], unsigned int *ncomp)
+{
+	PtBiNode V; unsigned int *Number, Root, NComp = 0; int Error;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (comp == NULL || ncomp == NULL) return NULL_PTR;
+
+	if ((Number = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int))) == NULL) return NO_MEM;
+
+	pthread_mutex_lock (&pdig->CacheLock);
+	if ((Error = Partition (pdig)) == OK)
+	{		/* numerar as componentes pela ordem do seu primeiro vértice */
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+			if (pdig->Parent[V->Number] == V->Number) Number[V->Number] = 0;
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+		{
+			Root = FindSet (pdig->Parent, V->Number);
+			if (Number[Root] == 0) Number[Root] = ++NComp;
+			comp[V->Number-1] = Number[Root];
+		}
+		*ncomp = NComp;
+	}
+	pthread_mutex_unlock (&pdig->CacheLock);
+
+	free (Number);
+	return Error;
+}
+
+PtDigraph DigraphCondensation (PtDigraph pdig)
+{
+
+	PtDigraph Cond; PtBiNode V, E;
+	unsigned int *Comp, NComp, C;
+
+	if (pdig == NULL || pdig->NVertexes == 0) return NULL;
+
+	if ((Comp = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int))) == NULL) return NULL;
+	if (DigraphSCC (pdig, Comp, &NComp) != OK || (Cond = Create (1)) == NULL)
+	{ free (Comp); return NULL; }
+
+	/* um vértice por componente */
+	for (C = 1; C <= NComp; C++)
+		if (InVertex (Cond, C) != OK) { Destroy (&Cond); free (Comp); return NULL; }
+
+	/* uma aresta entre componentes distintas; as repetidas são recusadas por InEdge */
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+		for (E = V->PtAdj; E != NULL; E = E->PtNext)
+			if (Comp[V->Number-1] != Comp[E->Number-1] &&
+			    InEdge (Cond, Comp[V->Number-1], Comp[E->Number-1], 1) == NO_MEM)
+			{ Destroy (&Cond); free (Comp); return NULL; }
+
+	free (Comp);
+	return Cond;
+
+}
+
+int DigraphTransitiveClosure (PtDigraph pdig)
+{
+	
+	PtBiNode V, E, Prev, *Vertexes;
+	BITWORD *Rows, *Row, *Succ, Word;
+	unsigned int *Comp, *Rank, *Start, *Merged, NComp, Words, C, R, W, B, I, NArcs = 0;
+	int Error = OK;
+  
+	/* Verifica se o digrafo existe */
+	if (pdig == NULL) return NO_DIGRAPH;
+      
+	/* Verifica se o digrafo não se encontra vazio */
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+
+	/* Matriz de bits do fecho: uma linha por componente fortemente conexa, com uma coluna por posição (rank) de vértice */
+	Words = BIT_WORDS (pdig->NVertexes);
+	Comp = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int));
+	Rank = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int));
+	Vertexes = (PtBiNode *) malloc (pdig->NVertexes * sizeof (PtBiNode));
+	Start = (unsigned int *) calloc (pdig->NVertexes + 2, sizeof (unsigned int));
+	Merged = (unsigned int *) calloc (pdig->NVertexes + 1, sizeof (unsigned int));
+	Rows = (BITWORD *) calloc ((size_t) Words * pdig->NVertexes, sizeof (BITWORD));
+	if (Comp == NULL || Rank == NULL || Vertexes == NULL || Start == NULL || Merged == NULL || Rows == NULL ||
+	    DigraphSCC (pdig, Comp, &NComp) != OK)
+	{ free (Comp); free (Rank); free (Vertexes); free (Start); free (Merged); free (Rows); return NO_MEM; }
+
+	/* Agrupa os vértices por componente: Vertexes[Start[C-1]..Start[C]-1] são os vértices da componente C */
+	for (V = pdig->Head, R = 0; V != NULL; V = V->PtNext, R++)
+	{
+		Rank[V->Number] = R;
+		Start[Comp[V->Number-1]+1]++;
+	}
+	for (C = 1; C <= NComp; C++) Start[C] += Start[C-1];	/* Start[C] passa a ser o início da componente C */
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+		Vertexes[Start[Comp[V->Number-1]]++] = V;	/* no fim, Start[C] é o fim da componente C */
+
+	/* Percorre as componentes por ordem topológica inversa, pelo que as linhas das sucessoras já estão completas */
+	for (C = NComp; C > 0; C--)
+	{
+		Row = Rows + (size_t) (C-1) * Words;
+
+		/* Os vértices de uma componente com mais de um vértice alcançam-se todos entre si */
+		if (Start[C] - Start[C-1] > 1)
+			for (I = Start[C-1]; I < Start[C]; I++) BIT_SET (Row, Rank[Vertexes[I]->Number]);
+
+		for (I = Start[C-1]; I < Start[C]; I++)
+			for (E = Vertexes[I]->PtAdj; E != NULL; E = E->PtNext)
+			{
+				BIT_SET (Row, Rank[E->Number]);	/* sucessor direto */
+				R = Comp[E->Number-1];
+				if (R == C || Merged[R] == C) continue;
+
+				/* Reunião palavra a palavra com a linha da componente sucessora (o ciclo é vetorizável pelo compilador) */
+				Merged[R] = C;
+				Succ = Rows + (size_t) (R-1) * Words;
+				for (W = 0; W < Words; W++) Row[W] |= Succ[W];
+			}
+	}
+
+	/* Volta a ordenar os vértices pela posição na lista de vértices */
+	for (V = pdig->Head; V != NULL; V = V->PtNext) Vertexes[Rank[V->Number]] = V;
+
+	/* Materializa cada linha do fecho numa única passagem pela lista ordenada de adjacências do vértice */
+	for (V = pdig->Head; V != NULL && Error == OK; V = V->PtNext)
+	{
+		Row = Rows + (size_t) (Comp[V->Number-1]-1) * Words;
+		if ((Error = OwnList (pdig, V)) != OK) break;
+		Prev = NULL; E = V->PtAdj;
+		for (W = 0; W < Words && Error == OK; W++)
+			for (Word = Row[W], B = W * WORD_BITS; Word != 0; Word >>= 1, B++)
+			{
+				if (!(Word & 1UL) || Vertexes[B] == V) continue;	/* lacetes proibidos */
+
+				/* avançar nas arestas já existentes com números inferiores */
+				while (E != NULL && E->Number < Vertexes[B]->Number) { Prev = E; E = E->PtNext; }
+				if (E != NULL && E->Number == Vertexes[B]->Number) continue;	/* aresta existente */
+
+				if ((Error = LinkEdge (pdig, V, Prev, Vertexes[B], 1)) != OK) break;
+				Prev = Prev == NULL ? V->PtAdj : Prev->PtNext;	/* a nova aresta */
+				NArcs++;
+			}
+	}
+
+	/* num grafo cada aresta nova foi ligada nos dois sentidos */
+	pdig->NEdges += pdig->Type ? NArcs : NArcs / 2;
+
+	free (Comp); free (Rank); free (Vertexes); free (Start); free (Merged); free (Rows);
+	return Error;
+
+}
+
+/************************* Árvore Geradora Mínima *************************/
+
+int DigraphMST (PtDigraph pdig, unsigned int palg, PtDigraph *ptree, unsigned int pedges[], int *pcost)
+{
+	PtDigraph Tree = NULL; struct arc *Arcs; unsigned int NTree = 0, I; int Error;
+
+	if (ptree != NULL) *ptree = NULL;
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pcost == NULL) return NULL_PTR;
+
+		/* arestas da floresta, com espaço para as repetir no sentido inverso */
+	if ((Arcs = (struct arc *) malloc (2 * pdig->NVertexes * sizeof (struct arc))) == NULL) return NO_MEM;
+
+	if (palg == MST_KRUSKAL) Error = KruskalForest (pdig, Arcs, &NTree);
+	else Error = PrimForest (pdig, Arcs, &NTree);
+
+	if (Error == OK)
+	{
+		for (*pcost = 0, I = 0; I < NTree; I++) *pcost += Arcs[I].Cost;
+
+		if (pedges != NULL)
+		{	/* lista de arestas: número de arestas seguido dos pares de vértices */
+			pedges[0] = NTree;
+			for (I = 0; I < NTree; I++) { pedges[2*I+1] = Arcs[I].V1; pedges[2*I+2] = Arcs[I].V2; }
+		}
+
+		if (ptree != NULL)
+		{	/* grafo com os mesmos vértices e as arestas da floresta nos dois sentidos */
+			for (I = 0; I < NTree; I++)
+			{ Arcs[NTree+I].V1 = Arcs[I].V2; Arcs[NTree+I].V2 = Arcs[I].V1; Arcs[NTree+I].Cost = Arcs[I].Cost; }
+			if ((Tree = CopyVertexes (pdig, 2 * NTree)) == NULL) Error = NO_MEM;
+			else
+			{
+				Tree->Type = 0; Tree->Incoming = 0;
+				if ((Error = BulkInsertEdges (Tree, Arcs, 2 * NTree)) != OK) Destroy (&Tree);
+			}
+			*ptree = Tree;
+		}
+	}
+
+	free (Arcs);
+	if (Error == OK && NTree < pdig->NVertexes - 1) return NO_CONNECTED;
+	return Error;
+}
+
+/************************* Instantâneo CSR Imutável *************************/
+
+PtDigraphCSR DigraphFreeze (PtDigraph pdig)
+{
+	PtDigraphCSR CSR; PtBiNode Vert, PEdge; unsigned int Index, Arc, NArcs = 0, MaxNumber = 0;
+
+	if (pdig == NULL) return NULL;
+
+					/* contar os arcos e determinar o maior número de vértice */
+	for (Vert = pdig->Head; Vert != NULL; Vert = Vert->PtNext)
+	{
+		NArcs += Vert->Elem.Vertex.OutDeg;
+		MaxNumber = Vert->Number;	/* a lista de vértices está ordenada */
+	}
+
+	if ((CSR = CreateCSR (pdig->NVertexes, NArcs, MaxNumber)) == NULL) return NULL;
+	CSR->NEdges = pdig->NEdges;
+	CSR->Type = pdig->Type;
+	CSR->PQueueKind = pdig->PQueueKind;
+
+					/* atribuir os índices densos aos vértices */
+	for (Vert = pdig->Head, Index = 0; Vert != NULL; Vert = Vert->PtNext, Index++)
+	{
+		CSR->Number[Index] = Vert->Number;
+		CSR->Map[Vert->Number] = Index;
+	}
+
+					/* copiar as listas de adjacências para as sequências contíguas */
+	for (Vert = pdig->Head, Index = 0, Arc = 0; Vert != NULL; Vert = Vert->PtNext, Index++)
+	{
+		CSR->Offset[Index] = Arc;
+		for (PEdge = Vert->PtAdj; PEdge != NULL; PEdge = PEdge->PtNext, Arc++)
+		{
+			CSR->Target[Arc] = CSR->Map[PEdge->Number];
+			CSR->Cost[Arc] = PEdge->Elem.Edge.Cost;
+		}
+	}
+	CSR->Offset[Index] = Arc;
+
+	return CSR;	/* devolve a referência do instantâneo criado */
+}
+
+int CSRDestroy (PtDigraphCSR *pcsr)
+{
+	PtDigraphCSR TmpCSR = *pcsr;
+
+	if (TmpCSR == NULL) return NO_DIGRAPH;
+
+	if (TmpCSR->Mapping != NULL)	/* as sequências pertencem à projeção do ficheiro */
+		munmap (TmpCSR->Mapping, TmpCSR->MappingSize);
+	else
+	{
+		free (TmpCSR->Number);
+		free (TmpCSR->Map);
+		free (TmpCSR->Offset);
+		free (TmpCSR->Target);
+		free (TmpCSR->Cost);
+	}
+	free (TmpCSR->ROffset); free (TmpCSR->RSource);
+	free (TmpCSR);
+	*pcsr = NULL;	/* colocar a referência do instantâneo a NULL */
+
+	return OK;
+}
+
+int CSRDijkstra (PtDigraphCSR pcsr, unsigned int pv, unsigned int pvpred[], int pvcost[])
+{
+	PtPQueue PQueue; unsigned char *Visit; unsigned int Source, Index, Arc, Target; int Cost; VERTEX Elem, Next;
+
+	if (pcsr == NULL) return NO_DIGRAPH;
+	if (pcsr->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pvpred == NULL || pvcost == NULL) return NULL_PTR;
+	if (pv > pcsr->MaxNumber || (Source = pcsr->Map[pv]) == NO_INDEX) return NO_VERTEX;
+
+	if ((Visit = (unsigned char *) calloc (pcsr->NVertexes, sizeof (unsigned char))) == NULL)
+		return NO_MEM;
+	if ((PQueue = PQueueCreateKind (pcsr->NVertexes, pcsr->PQueueKind)) == NULL) { free (Visit); return NO_MEM; }
+
+					/* inicializar os vértices; a fila identifica-os pelo índice */
+	for (Index = 0; Index < pcsr->NVertexes; Index++)
+	{
+		pvpred[pcsr->Number[Index]-1] = 0;
+		pvcost[pcsr->Number[Index]-1] = INT_MAX;
+	}
+	Elem.Vertex = Source; Elem.Cost = pvcost[pv-1] = 0;
+	PQueueInsert (PQueue, &Elem);	/* inserção preguiçosa do vértice de partida */
+
+	while (!PQueueIsEmpty (PQueue))
+	{
+		PQueueDeleteMin (PQueue, &Elem);
+		Visit[Elem.Vertex] = 1;	/* marcar o vértice como conhecido */
+
+		for (Arc = pcsr->Offset[Elem.Vertex]; Arc < pcsr->Offset[Elem.Vertex+1]; Arc++)
+		{
+			Target = pcsr->Target[Arc];
+			if (Visit[Target]) continue;	/* não processar vértices conhecidos */
+			Cost = Elem.Cost + pcsr->Cost[Arc];
+			if (Cost < pvcost[pcsr->Number[Target]-1])
+			{
+				pvpred[pcsr->Number[Target]-1] = pcsr->Number[Elem.Vertex];
+				pvcost[pcsr->Number[Target]-1] = Cost;
+				Next.Vertex = Target; Next.Cost = Cost;
+				if (PQueueContains (PQueue, Target) == OK) PQueueDecrease (PQueue, &Next);
+				else PQueueInsert (PQueue, &Next);
+			}
+		}
+	}
+
+	PQueueDestroy (&PQueue);
+	free (Visit);
+	return OK;
+}
+
+int CSRReach (PtDigraphCSR pcsr, unsigned int pv, unsigned int pvlist[])
+{
+	unsigned char *Visit; unsigned int *Queue, Source, Index, Count = 0;
+
+	if (pcsr == NULL) return NO_DIGRAPH;
+	if (pcsr->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pvlist == NULL) return NULL_PTR;
+	if (pv > pcsr->MaxNumber || (Source = pcsr->Map[pv]) == NO_INDEX) return NO_VERTEX;
+
+	if ((Visit = (unsigned char *) calloc (pcsr->NVertexes, sizeof (unsigned char))) == NULL)
+		return NO_MEM;
+	if ((Queue = (unsigned int *) malloc (pcsr->NVertexes * sizeof (unsigned int))) == NULL)
+	{ free (Visit); return NO_MEM; }
+
+	CSRSearch (Source, pcsr->Offset, pcsr->Target, Visit, Queue);
+
+			/* os índices crescentes correspondem aos números crescentes dos vértices */
+	for (Index = 0; Index < pcsr->NVertexes; Index++)
+		if (Visit[Index] && Index != Source) pvlist[++Count] = pcsr->Number[Index];
+	pvlist[0] = Count;
+
+	free (Queue);
+	free (Visit);
+	return OK;
+}
+
+int CSRStronglyConnected (PtDigraphCSR pcsr, unsigned int *pstrong)
+{
+	unsigned char *Visit; unsigned int *Queue;
+
+	if (pcsr == NULL) return NO_DIGRAPH;
+	if (pcsr->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pstrong == NULL) return NULL_PTR;
+
+	if ((Visit = (unsigned char *) calloc (pcsr->NVertexes, sizeof (unsigned char))) == NULL)
+		return NO_MEM;
+	if ((Queue = (unsigned int *) malloc (pcsr->NVertexes * sizeof (unsigned int))) == NULL)
+	{ free (Visit); return NO_MEM; }
+
+					/* todos os vértices alcançáveis a partir do primeiro? */
+	if (CSRSearch (0, pcsr->Offset, pcsr->Target, Visit, Queue) != pcsr->NVertexes)
+	{ *pstrong = 0; free (Queue); free (Visit); return OK; }
+
+	if (!pcsr->Type)	/* num grafo a pesquisa inversa é igual à direta */
+	{ *pstrong = 1; free (Queue); free (Visit); return OK; }
+
+					/* adjacências inversas (dígrafo transposto), guardadas no instantâneo */
+	if (CSRReverse (pcsr) == NO_MEM) { free (Queue); free (Visit); return NO_MEM; }
+
+					/* o primeiro vértice é alcançável a partir de todos? */
+	memset (Visit, 0, pcsr->NVertexes);
+	*pstrong = CSRSearch (0, pcsr->ROffset, pcsr->RSource, Visit, Queue) == pcsr->NVertexes;
+
+	free (Queue); free (Visit);
+	return OK;
+}
+
+PtDigraphCSR CSRTransitiveClosure (PtDigraphCSR pcsr)
+{
+	PtDigraphCSR Closure; unsigned char *Visit; unsigned int *Queue, *Target, Source, Index, Arc, Old, NArcs = 0;
+	int *Cost;
+
+	if (pcsr == NULL) return NULL;
+
+	if ((Visit = (unsigned char *) calloc (pcsr->NVertexes + 1, sizeof (unsigned char))) == NULL)
+		return NULL;
+	if ((Queue = (unsigned int *) malloc ((pcsr->NVertexes + 1) * sizeof (unsigned int))) == NULL)
+	{ free (Visit); return NULL; }
+	if ((Closure = CreateCSR (pcsr->NVertexes, 0, pcsr->MaxNumber)) == NULL)
+	{ free (Queue); free (Visit); return NULL; }
+	Closure->Type = pcsr->Type;
+	Closure->PQueueKind = pcsr->PQueueKind;
+
+	memcpy (Closure->Number, pcsr->Number, pcsr->NVertexes * sizeof (unsigned int));
+	memcpy (Closure->Map, pcsr->Map, (pcsr->MaxNumber + 1) * sizeof (unsigned int));
+
+	for (Source = 0; Source < pcsr->NVertexes; Source++)
+	{
+		Closure->Offset[Source] = NArcs;
+		memset (Visit, 0, pcsr->NVertexes);
+		CSRSearch (Source, pcsr->Offset, pcsr->Target, Visit, Queue);
+		Visit[Source] = 0;	/* os lacetes são proibidos */
+
+		for (Index = 0; Index < pcsr->NVertexes; Index++)
+			if (Visit[Index]) NArcs++;
+		if (NArcs > Closure->NArcs)
+		{		/* aumentar a capacidade das sequências dos arcos do fecho */
+			Closure->NArcs = 2 * NArcs;
+			Target = (unsigned int *) realloc (Closure->Target, Closure->NArcs * sizeof (unsigned int));
+			if (Target != NULL) Closure->Target = Target;
+			Cost = (int *) realloc (Closure->Cost, Closure->NArcs * sizeof (int));
+			if (Cost != NULL) Closure->Cost = Cost;
+			if (Target == NULL || Cost == NULL)
+			{ CSRDestroy (&Closure); free (Queue); free (Visit); return NULL; }
+		}
+
+				/* fundir os vértices alcançáveis com as arestas já existentes */
+		for (Index = 0, Arc = Closure->Offset[Source], Old = pcsr->Offset[Source]; Index < pcsr->NVertexes; Index++)
+			if (Visit[Index])
+			{
+				while (Old < pcsr->Offset[Source+1] && pcsr->Target[Old] < Index) Old++;
+				Closure->Target[Arc] = Index;
+				if (Old < pcsr->Offset[Source+1] && pcsr->Target[Old] == Index)
+					Closure->Cost[Arc++] = pcsr->Cost[Old];
+				else Closure->Cost[Arc++] = 1;
+			}
+	}
+	Closure->Offset[pcsr->NVertexes] = Closure->NArcs = NArcs;
+	Closure->NEdges = Closure->Type ? NArcs : NArcs / 2;
+
+	free (Queue);
+	free (Visit);
+	return Closure;
+}
+
+int CSRBreadthFirst (PtDigraphCSR pcsr, unsigned int pv, unsigned int pnthreads, unsigned int pvpred[], int pvcost[])
+{
+	struct breadthjob Job; pthread_t *Threads; unsigned int Source, Created = 0, I;
+
+	if (pcsr == NULL) return NO_DIGRAPH;
+	if (pcsr->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pvpred == NULL || pvcost == NULL) return NULL_PTR;
+	if (pv > pcsr->MaxNumber || (Source = pcsr->Map[pv]) == NO_INDEX) return NO_VERTEX;
+
+	if (pnthreads == 0)	/* um fio por processador disponível */
+	{
+		long NProc = sysconf (_SC_NPROCESSORS_ONLN);
+		pnthreads = NProc > 0 ? (unsigned int) NProc : 1;
+	}
+	Job.Words = BIT_WORDS (pcsr->NVertexes);	/* fios sem palavras para pesquisar só esperariam */
+	if (pnthreads > (Job.Words + BFS_CHUNK - 1) / BFS_CHUNK) pnthreads = (Job.Words + BFS_CHUNK - 1) / BFS_CHUNK;
+
+	if ((Job.Visit = (BITWORD *) calloc (3 * (size_t) Job.Words, sizeof (BITWORD))) == NULL) return NO_MEM;
+	if ((Job.Parts = (struct breadthpart *) calloc (pnthreads, sizeof (struct breadthpart))) == NULL)
+	{ free (Job.Visit); return NO_MEM; }
+	if (pthread_mutex_init (&Job.Lock, NULL) != 0) { free (Job.Parts); free (Job.Visit); return NO_MEM; }
+	if (pthread_cond_init (&Job.Wake, NULL) != 0)
+	{ pthread_mutex_destroy (&Job.Lock); free (Job.Parts); free (Job.Visit); return NO_MEM; }
+
+	Job.CSR = pcsr; Job.Frontier = Job.Visit + Job.Words; Job.Next = Job.Frontier + Job.Words;
+	Job.ROffset = Job.RSource = NULL; Job.Pred = pvpred; Job.Cost = pvcost;
+	Job.Cursor = Job.Level = Job.BottomUp = Job.Count = Job.Done = 0; Job.Unexplored = pcsr->NArcs;
+	Job.NParts = pnthreads; Job.Threads = Job.Waiting = Job.Round = 0;
+	for (I = 0; I < pnthreads; I++) Job.Parts[I].Job = &Job;
+
+			/* o vértice de partida é a fronteira seguinte do nível 0 */
+	BIT_SET (Job.Visit, Source); BIT_SET (Job.Next, Source);
+	Job.Parts[0].Count = 1; Job.Parts[0].Arcs = pcsr->Offset[Source+1] - pcsr->Offset[Source];
+
+	/* os fios adicionais; o fio que chama também trabalha */
+	if ((Threads = (pthread_t *) malloc (pnthreads * sizeof (pthread_t))) != NULL)
+		for (I = 1; I < pnthreads; I++)
+			if (pthread_create (&Threads[Created], NULL, BreadthWorker, &Job.Parts[I]) == 0) Created++;
+
+	pthread_mutex_lock (&Job.Lock);	/* só agora se sabe quantos fios esperam na barreira */
+	Job.Threads = Created + 1;
+	pthread_mutex_unlock (&Job.Lock);
+
+	BreadthWorker (&Job.Parts[0]);
+
+	for (I = 0; I < Created; I++) pthread_join (Threads[I], NULL);
+	free (Threads);
+	pthread_cond_destroy (&Job.Wake); pthread_mutex_destroy (&Job.Lock);
+	free (Job.Parts); free (Job.Visit);
+
+	pvcost[pv-1] = 0;	/* o predecessor do vértice de partida já é 0 */
+	return OK;
+}
+
+/************************* Reordenação dos Vértices *************************/
+
+int DigraphReorder (PtDigraph pdig, unsigned int pstrategy, unsigned int pperm[])
+{
+	PtDigraphCSR CSR; PtDigraph Tmp = NULL; unsigned int *Order, I;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pperm == NULL) return NULL_PTR;
+
+	/* a ordem é calculada sobre um instantâneo CSR e o dígrafo é reconstruído já renumerado */
+	if ((CSR = DigraphFreeze (pdig)) == NULL) return NO_MEM;
+	if ((Order = (unsigned int *) malloc (CSR->NVertexes * sizeof (unsigned int))) == NULL ||
+	    ReorderCSR (CSR, pstrategy, Order) != OK || (Tmp = RelabelCSR (CSR, Order, pdig->Incoming)) == NULL)
+	{ free (Order); CSRDestroy (&CSR); return NO_MEM; }
+
+	for (I = 0; I < CSR->NVertexes; I++) pperm[I] = CSR->Number[Order[I]];
+	free (Order); CSRDestroy (&CSR);
+
+	/* trocar as estruturas, libertando a antiga com o dígrafo temporário */
+	SwapStructure (pdig, Tmp);
+	pdig->Version++;	/* as caches deixam de valer */
+	Destroy (&Tmp);
+
+	return OK;
+}
+
+PtDigraphCSR CSRReorder (PtDigraphCSR pcsr, unsigned int pstrategy, unsigned int pperm[])
+{
+	PtDigraphCSR CSR = NULL; PtDigraph Tmp = NULL; unsigned int *Order, I;
+
+	if (pcsr == NULL || pcsr->NVertexes == 0 || pperm == NULL) return NULL;
+
+	if ((Order = (unsigned int *) malloc (pcsr->NVertexes * sizeof (unsigned int))) != NULL &&
+	    ReorderCSR (pcsr, pstrategy, Order) == OK && (Tmp = RelabelCSR (pcsr, Order, 0)) != NULL &&
+	    (CSR = DigraphFreeze (Tmp)) != NULL)
+		for (I = 0; I < pcsr->NVertexes; I++) pperm[I] = pcsr->Number[Order[I]];
+
+	free (Order);
+	if (Tmp != NULL) Destroy (&Tmp);
+	return CSR;	/* devolve a referência do instantâneo criado */
+}
+
+/************************* Ficheiro Binário CSR *************************/
+
+int CSRStoreFile (PtDigraphCSR pcsr, char *pfilename)
+{
+	FILE *PtF; struct csrheader Header; int Error = OK;
+
+	if (pcsr == NULL) return NO_DIGRAPH;
+
+	if ((PtF = fopen (pfilename, "wb")) == NULL) return NO_FILE;
+
+	Header.Magic = CSR_MAGIC; Header.Version = CSR_VERSION;
+	Header.Type = pcsr->Type; Header.NVertexes = pcsr->NVertexes;
+	Header.NEdges = pcsr->NEdges; Header.NArcs = pcsr->NArcs;
+	Header.MaxNumber = pcsr->MaxNumber; Header.Reserved = 0;
+
+					/* cabeçalho seguido das sequências, pela ordem da projeção */
+	if (fwrite (&Header, sizeof (struct csrheader), 1, PtF) != 1
+		|| fwrite (pcsr->Number, sizeof (unsigned int), pcsr->NVertexes, PtF) != pcsr->NVertexes
+		|| fwrite (pcsr->Offset, sizeof (unsigned int), pcsr->NVertexes + 1, PtF) != pcsr->NVertexes + 1
+		|| fwrite (pcsr->Target, sizeof (unsigned int), pcsr->NArcs, PtF) != pcsr->NArcs
+		|| fwrite (pcsr->Cost, sizeof (int), pcsr->NArcs, PtF) != pcsr->NArcs
+		|| fwrite (pcsr->Map, sizeof (unsigned int), pcsr->MaxNumber + 1, PtF) != pcsr->MaxNumber + 1)
+		Error = NO_FILE;
+
+	if (fclose (PtF) != 0) Error = NO_FILE;
+	return Error;
+}
+
+PtDigraphCSR CSRMapFile (char *pfilename)
+{
+	PtDigraphCSR CSR; struct csrheader *Header; struct stat Info;
+	void *Mapping; unsigned int *Data; size_t Size, Words; int Fd;
+
+	if (pfilename == NULL || (Fd = open (pfilename, O_RDONLY)) < 0) return NULL;
+	if (fstat (Fd, &Info) < 0 || (size_t) Info.st_size < sizeof (struct csrheader))
+	{ close (Fd); return NULL; }
+
+	Size = (size_t) Info.st_size;
+	Mapping = mmap (NULL, Size, PROT_READ, MAP_PRIVATE, Fd, 0);
+	close (Fd);	/* a projeção mantém-se depois do fecho do descritor */
+	if (Mapping == MAP_FAILED) return NULL;
+
+					/* validar o cabeçalho e a dimensão do ficheiro */
+	Header = (struct csrheader *) Mapping;
+	Data = (unsigned int *) (Header + 1);
+	Words = 2 * (size_t) Header->NVertexes + 1 + 2 * (size_t) Header->NArcs + (size_t) Header->MaxNumber + 1;
+	if (Header->Magic != CSR_MAGIC || Header->Version != CSR_VERSION
+		|| Size != sizeof (struct csrheader) + Words * sizeof (unsigned int)
+		|| Data[Header->NVertexes + Header->NVertexes] != Header->NArcs)
+	{ munmap (Mapping, Size); return NULL; }
+
+	if ((CSR = (PtDigraphCSR) malloc (sizeof (struct csr))) == NULL)
+	{ munmap (Mapping, Size); return NULL; }
+
+	CSR->NVertexes = Header->NVertexes; CSR->NEdges = Header->NEdges;
+	CSR->NArcs = Header->NArcs; CSR->Type = Header->Type;
+	CSR->MaxNumber = Header->MaxNumber; CSR->PQueueKind = PQUEUE_BINARY;
+	CSR->Mapping = Mapping; CSR->MappingSize = Size;
+	CSR->ROffset = CSR->RSource = NULL;
+
+					/* as sequências são usadas diretamente no ficheiro projetado */
+	CSR->Number = Data; Data += CSR->NVertexes;
+	CSR->Offset = Data; Data += CSR->NVertexes + 1;
+	CSR->Target = Data; Data += CSR->NArcs;
+	CSR->Cost = (int *) Data; Data += CSR->NArcs;
+	CSR->Map = Data;
+
+	if (!CSRValid (CSR)) { munmap (Mapping, Size); free (CSR); return NULL; }	/* ficheiro truncado ou corrompido */
+	return CSR;	/* devolve o instantâneo projetado */
+}
+
+int ConvertFile (char *ptextname, char *pbinname)
+{
+	PtDigraph Digraph; PtDigraphCSR CSR; int Error;
+
+	if ((Digraph = CreateFile (ptextname)) == NULL) return NO_FILE;
+
+	CSR = DigraphFreeze (Digraph);
+	Destroy (&Digraph);
+	if (CSR == NULL) return NO_MEM;
+
+	Error = CSRStoreFile (CSR, pbinname);
+	CSRDestroy (&CSR);
+	return Error;
+}
+
+/***************** Definição dos Subprogramas Internos *****************/
+
+/* Função que insere, de facto, uma aresta no dígrafo/grafo. Em caso de sucesso devolve OK, senão devolve NO_MEM para assinalar falta de memória. */
+
+static int InsertEdge (PtDigraph pdig, PtBiNode pv1, PtBiNode pv2, int pcost)
+{
+					/* determinar posição de colocação e inserir a aresta */
+	if (pv1->PtAdj == NULL || pv1->PtAdj->Number > pv2->Number)
+		return LinkEdge (pdig, pv1, NULL, pv2, pcost);	/* inserção à cabeça da lista das arestas */
+	else	/* inserção à frente do nó de inserção */
+		return LinkEdge (pdig, pv1, InPosition (pv1->PtAdj, pv2->Number), pv2, pcost);
+}
+
+/* Função que cria a aresta pv1-pv2 e a liga na lista de adjacências de pv1 à frente do binó pprev (ou à cabeça, se pprev for NULL), sem verificar a ordenação. Se o dígrafo mantém as listas de arcos incidentes, cria também o binó gémeo na lista de pv2. Em caso de sucesso devolve OK, senão devolve NO_MEM para assinalar falta de memória. */
+
+static int LinkEdge (PtDigraph pdig, PtBiNode pv1, PtBiNode pprev, PtBiNode pv2, int pcost)
+{
+	PtBiNode Node, Twin = NULL;	/* nova aresta e o seu gémeo */
+
+					/* criar o binó com a aresta */
+	if ((Node = CreateBiNode (pdig, pv2->Number)) == NULL) return NO_MEM;
+	if (pdig->Incoming && pdig->Type && (Twin = CreateBiNode (pdig, pv1->Number)) == NULL)
+	{ DestroyBiNode (pdig, &Node); return NO_MEM; }
+	Node->Elem.Edge.Cost = pcost;	/* armazena o custo da aresta */
+	if (pcost < 0) pdig->NNegative++;
+
+	if (pprev == NULL)
+	{				/* inserção à cabeça da lista das arestas */
+		Node->PtNext = pv1->PtAdj; pv1->PtAdj = Node;
+	}
+	else
+	{				/* inserção à frente do nó pprev */
+		Node->PtNext = pprev->PtNext;
+		Node->PtPrev = pprev; pprev->PtNext = Node;
+	}
+	if (Node->PtNext != NULL) Node->PtNext->PtPrev = Node;
+
+	Node->PtAdj = pv2;	/* ligar o vértice 1 ao vértice 2 */
+	if (Twin != NULL) LinkIncoming (pv1, Node, Twin);
+	/* incrementar semigraus dos vértices emergente do 1 e incidente do 2 */
+	pv1->Elem.Vertex.OutDeg++;
+	pv2->Elem.Vertex.InDeg++;
+
+	return OK;
+}
+
+/* Função que liga o binó ptwin, gémeo do arco parc que sai de pv1, à cabeça da lista de arcos incidentes do vértice de chegada. As listas de arcos incidentes não são ordenadas. */
+
+static void LinkIncoming (PtBiNode pv1, PtBiNode parc, PtBiNode ptwin)
+{
+	PtBiNode Target = parc->PtAdj;
+
+	ptwin->PtAdj = pv1;	/* ligar o gémeo ao vértice de partida */
+	ptwin->Elem.Edge.Cost = parc->Elem.Edge.Cost;
+	ptwin->Elem.Edge.PtTwin = parc; parc->Elem.Edge.PtTwin = ptwin;
+
+	ptwin->PtNext = Target->Elem.Vertex.PtIn;
+	if (ptwin->PtNext != NULL) ptwin->PtNext->PtPrev = ptwin;
+	Target->Elem.Vertex.PtIn = ptwin;
+}
+
+/* Função que remove, de facto, uma aresta do dígrafo/grafo. */
+
+static void DeleteEdge (PtDigraph pdig, PtBiNode pv1, PtBiNode pv2)
+{
+					/* determinar posição de remoção da aresta */
+	UnlinkArc (pdig, pv1, OutPosition (pv1->PtAdj, pv2->Number));
+}
+
+/* Função que retira o arco parc da lista de adjacências de pv1 e, se existir, o seu gémeo da lista de arcos incidentes do vértice de chegada, atualizando os semigraus, em tempo constante. */
+
+static void UnlinkArc (PtDigraph pdig, PtBiNode pv1, PtBiNode parc)
+{
+	PtBiNode Target = parc->PtAdj, Twin = parc->Elem.Edge.PtTwin;
+
+	if (parc == pv1->PtAdj)	/* remoção da aresta */
+	{				/* remoção da aresta da cabeça da lista das arestas */
+		if (parc->PtNext != NULL) parc->PtNext->PtPrev = NULL;
+		pv1->PtAdj = parc->PtNext;
+	}
+	else
+	{				/* remoção de outra aresta do vértice */
+		parc->PtPrev->PtNext = parc->PtNext;
+		if (parc->PtNext != NULL) parc->PtNext->PtPrev = parc->PtPrev;
+	}
+
+	if (Twin != NULL)
+	{				/* remoção do gémeo da lista de arcos incidentes */
+		if (Twin == Target->Elem.Vertex.PtIn) Target->Elem.Vertex.PtIn = Twin->PtNext;
+		else Twin->PtPrev->PtNext = Twin->PtNext;
+		if (Twin->PtNext != NULL) Twin->PtNext->PtPrev = Twin->PtPrev;
+		DestroyBiNode (pdig, &Twin);
+	}
+	if (parc->Elem.Edge.Cost < 0) pdig->NNegative--;
+	DestroyBiNode (pdig, &parc);	/* destruir binó com aresta */
+
+	/* decrementar semigraus dos vértices emergente do 1 e incidente do 2 */
+	pv1->Elem.Vertex.OutDeg--;
+	Target->Elem.Vertex.InDeg--;
+}
+
+/* Função que cria o binó da lista de vértices ou da lista de arestas, reutilizando um binó libertado ou retirando-o do bloco atual do dígrafo pdig (que é substituído por um novo bloco, com o dobro da capacidade, quando se esgota). O elemento do binó fica a zero. Devolve a referência do binó criado ou NULL, caso não consiga criá-lo por falta de memória. */
+
+static PtBiNode CreateBiNode (PtDigraph pdig, unsigned int pnumber)
+{
+	PtBiNode Node;
+
+	if (pdig->FreeNodes != NULL)
+	{				/* reutilizar um binó libertado */
+		Node = pdig->FreeNodes; pdig->FreeNodes = Node->PtNext;
+	}
+	else
+	{
+		if (pdig->Slabs == NULL || pdig->Slabs->Used == pdig->Slabs->Size)
+			if (ReserveNodes (pdig, 1) != OK) return NULL;
+		Node = &pdig->Slabs->Nodes[pdig->Slabs->Used++];
+	}
+
+	Node->PtNext = NULL;	/* binó aponta para a frente para NULL */
+	Node->PtPrev = NULL;	/* binó aponta para a trás para NULL */
+	Node->PtAdj = NULL;	/* lista de adjacências nula */
+	Node->Number = pnumber;	/* armazena o identificador do binó */
+	Node->Elem.Vertex.InDeg = Node->Elem.Vertex.OutDeg = 0;	/* inicializa os semigraus */
+	Node->Elem.Vertex.PtIn = NULL;
+	Node->Elem.Edge.Cost = 0;
+	Node->Elem.Edge.PtTwin = NULL;
+	pdig->Version++;	/* a estrutura mudou: o índice inverso deixa de valer */
+	return Node;	/* devolve o binó criado */
+}
+
+/* Função que devolve o binó à lista de binós livres do dígrafo pdig. A memória só é libertada, em bloco, por Destroy. */
+
+static void DestroyBiNode (PtDigraph pdig, PtBiNode *pbinode)
+{
+	if (*pbinode == NULL) return;
+
+	(*pbinode)->PtNext = pdig->FreeNodes;
+	pdig->FreeNodes = *pbinode;
+	pdig->Version++;
+	*pbinode = NULL;
+}
+
+/* Função que garante que o bloco atual do dígrafo pdig tem pelo menos pn binós por entregar, reservando, se necessário, um novo bloco com o dobro da capacidade do anterior (entre SLAB_MIN e SLAB_MAX) ou com pn binós, se for maior. Devolve OK ou NO_MEM. */
+
+static int ReserveNodes (PtDigraph pdig, unsigned int pn)
+{
+	struct slab *Slab; unsigned int Size;
+
+	if (pdig->Slabs != NULL && pdig->Slabs->Size - pdig->Slabs->Used >= pn) return OK;
+
+	Size = pdig->Slabs == NULL ? SLAB_MIN : pdig->Slabs->Size < SLAB_MAX ? 2 * pdig->Slabs->Size : SLAB_MAX;
+	if (Size < pn) Size = pn;
+
+	if ((Slab = (struct slab *) malloc (sizeof (struct slab) + (Size - 1) * sizeof (struct binode))) == NULL)
+		return NO_MEM;
+	Slab->Size = Size; Slab->Used = 0; Slab->Refs = 1;
+	Slab->Next = pdig->Slabs; pdig->Slabs = Slab;
+	return OK;
+}
+
+/* Função que cria um dígrafo/grafo do mesmo tipo de pdig, com os mesmos vértices, sem arestas e com a mesma opção de listas de arcos incidentes, e reserva de uma só vez os binós dos vértices e de pnarcs arcos. Devolve a referência do dígrafo/grafo criado ou NULL, caso não consiga criá-lo por falta de memória. */
+
+static PtDigraph CopyVertexes (PtDigraph pdig, unsigned int pnarcs)
+{
+	PtDigraph Copy; PtBiNode Vert, Node, Tail = NULL;
+
+	if ((Copy = Create (pdig->Type)) == NULL) return NULL;
+	Copy->PQueueKind = pdig->PQueueKind;
+	Copy->Incoming = pdig->Incoming;
+	if (Copy->Incoming && Copy->Type) pnarcs *= 2;	/* cada arco tem o seu gémeo */
+
+	if (ReserveNodes (Copy, pdig->NVertexes + pnarcs) != OK ||
+	    (pdig->IndexSize > 0 && GrowIndex (Copy, pdig->IndexSize - 1) != OK))
+	{ Destroy (&Copy); return NULL; }
+
+				/* acrescentar os vértices pela ordem da lista de vértices */
+	for (Vert = pdig->Head; Vert != NULL; Vert = Vert->PtNext, Tail = Node)
+	{
+		Node = CreateBiNode (Copy, Vert->Number);
+		if (Tail == NULL) Copy->Head = Node;
+		else { Tail->PtNext = Node; Node->PtPrev = Tail; }
+		Copy->Index[Vert->Number] = Node;
+	}
+	Copy->NVertexes = pdig->NVertexes;
+
+	return Copy;	/* devolve o dígrafo criado */
+}
+
+/* Função que faz a cópia pcopy, com os vértices já copiados, partilhar as listas de adjacências de pdig: cada lista recebe uma partilha contada (criada num só bloco para as listas que ainda não estavam partilhadas) e a cópia passa a referenciar os blocos de binós de pdig, que só são libertados pelo último dígrafo que os usa. Devolve OK ou NO_MEM. */
+
+static int ShareLists (PtDigraph pdig, PtDigraph pcopy)
+{
+	PtBiNode V, C; struct slab *Slab; struct slabref *Ref, *Refs = NULL, *Borrowed;
+	struct shareblock *Block = NULL; struct listshare *Share; unsigned int NNew = 0;
+
+	if (pdig->Head == NULL) return OK;	/* dígrafo sem vértices */
+	if ((pcopy->Share = (struct listshare **) calloc (pcopy->IndexSize, sizeof (struct listshare *))) == NULL)
+		return NO_MEM;
+
+	/* uma referência por cada bloco de binós de pdig, próprio ou partilhado */
+	for (Slab = pdig->Slabs, Borrowed = pdig->Borrowed; Slab != NULL || Borrowed != NULL; )
+	{
+		if ((Ref = (struct slabref *) malloc (sizeof (struct slabref))) == NULL)
+		{
+			while ((Ref = Refs) != NULL) { Refs = Ref->Next; free (Ref); }
+			return NO_MEM;
+		}
+		if (Slab != NULL) { Ref->Slab = Slab; Slab = Slab->Next; }
+		else { Ref->Slab = Borrowed->Slab; Borrowed = Borrowed->Next; }
+		Ref->Next = Refs; Refs = Ref;
+	}
+
+	/* a tabela de partilhas de pdig só é criada e alterada com a exclusão mútua,
+	   porque várias cópias do mesmo dígrafo podem ser feitas ao mesmo tempo */
+	pthread_mutex_lock (&ShareLock);
+	if (pdig->Share == NULL)
+		pdig->Share = (struct listshare **) calloc (pdig->IndexSize, sizeof (struct listshare *));
+	if (pdig->Share != NULL)	/* um bloco com as partilhas das listas ainda não partilhadas */
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+			if (V->PtAdj != NULL && pdig->Share[V->Number] == NULL) NNew++;
+	if (pdig->Share == NULL || (NNew > 0 && (Block = (struct shareblock *) malloc (sizeof (struct shareblock) + (NNew - 1) * sizeof (struct listshare))) == NULL))
+	{
+		pthread_mutex_unlock (&ShareLock);
+		while ((Ref = Refs) != NULL) { Refs = Ref->Next; free (Ref); }
+		return NO_MEM;
+	}
+
+	if (Block != NULL) Block->Live = 0;
+	for (V = pdig->Head, C = pcopy->Head; V != NULL; V = V->PtNext, C = C->PtNext)
+	{
+		C->Elem.Vertex.InDeg = V->Elem.Vertex.InDeg; C->Elem.Vertex.OutDeg = V->Elem.Vertex.OutDeg;
+		if (V->PtAdj == NULL) continue;
+
+		if ((Share = pdig->Share[V->Number]) == NULL)
+		{			/* a lista passa a ser partilhada */
+			Share = &Block->Shares[Block->Live++];
+			Share->Refs = 1; Share->Block = Block;
+			pdig->Share[V->Number] = Share;
+		}
+		Share->Refs++;
+		pcopy->Share[V->Number] = Share;
+		C->PtAdj = V->PtAdj;
+	}
+	for (Ref = Refs; Ref != NULL; Ref = Ref->Next) Ref->Slab->Refs++;
+	pthread_mutex_unlock (&ShareLock);
+
+	pcopy->Borrowed = Refs;
+	pcopy->NEdges = pdig->NEdges;
+	pcopy->NNegative = pdig->NNegative;
+	return OK;
+}
+
+/* Função que torna própria do dígrafo a lista de adjacências do vértice pv, antes de ela ser alterada. Uma lista ainda partilhada com outro dígrafo é clonada; a última referência a uma lista fica com ela, apenas ligando os arcos aos seus vértices, dado que os binós podem ter sido criados por outro dígrafo. Devolve OK ou NO_MEM. */
+
+static int OwnList (PtDigraph pdig, PtBiNode pv)
+{
+	PtBiNode E, Node, Tail = NULL; unsigned int Refs;
+
+	if (pdig->Share == NULL || pdig->Share[pv->Number] == NULL) return OK;
+
+	pthread_mutex_lock (&ShareLock);
+	Refs = pdig->Share[pv->Number]->Refs;
+	pthread_mutex_unlock (&ShareLock);
+
+	if (Refs > 1)
+	{				/* clonar a lista, que ainda é usada por outros dígrafos */
+		if (ReserveNodes (pdig, pv->Elem.Vertex.OutDeg) != OK) return NO_MEM;
+		for (E = pv->PtAdj; E != NULL; E = E->PtNext, Tail = Node)
+		{
+			Node = CreateBiNode (pdig, E->Number);
+			Node->Elem.Edge.Cost = E->Elem.Edge.Cost;
+			if (Tail == NULL) pv->PtAdj = Node;
+			else { Tail->PtNext = Node; Node->PtPrev = Tail; }
+		}
+	}
+
+	for (E = pv->PtAdj; E != NULL; E = E->PtNext) E->PtAdj = pdig->Index[E->Number];
+	ReleaseShare (pdig, pv->Number);
+	return OK;
+}
+
+/* Função que larga a partilha da lista de adjacências do vértice pnumber, libertando o bloco de partilhas quando nenhuma delas está em uso. */
+
+static void ReleaseShare (PtDigraph pdig, unsigned int pnumber)
+{
+	struct listshare *Share = pdig->Share[pnumber];
+
+	pdig->Share[pnumber] = NULL;
+	pthread_mutex_lock (&ShareLock);
+	if (--Share->Refs == 0 && --Share->Block->Live == 0) free (Share->Block);
+	pthread_mutex_unlock (&ShareLock);
+}
+
+/* Função de pesquisa para inserção. Devolve um ponteiro para o binó à frente do qual deve ser feita a inserção do novo vértice (nova aresta) ou NULL, caso o vértice (a aresta) já exista. */
+ 
+static PtBiNode InPosition (PtBiNode phead, unsigned int pnumber)
+{
+	PtBiNode Node, Prev;
+
+	for (Node = phead; Node != NULL; Node = Node->PtNext)
+	{
+		if (Node->Number >= pnumber) break;
+		Prev = Node;
+	}
+
+	if (Node == NULL || Node->Number > pnumber) return Prev;
+	else return NULL;	/* o elemento já existe */
+}
+
+/* Função de pesquisa para remoção. Devolve um ponteiro para o binó onde se encontra o vértice (a aresta) ou NULL, caso o vértice (a aresta) não exista. */
+
+static PtBiNode OutPosition (PtBiNode phead, unsigned int pnumber)
+{
+	PtBiNode Node;
+
+	for (Node = phead; Node != NULL; Node = Node->PtNext)
+		if (Node->Number == pnumber) break;
+	return Node;
+}
+
+/* Função de pesquisa de um vértice na tabela de acesso direto. Devolve um ponteiro para o binó do vértice pnumber ou NULL, caso o vértice não exista. */
+
+static PtBiNode VertexPosition (PtDigraph pdig, unsigned int pnumber)
+{
+	if (pnumber >= pdig->IndexSize) return NULL;
+	return pdig->Index[pnumber];
+}
+
+/* Função que devolve o vértice de maior número inferior a pnumber ou NULL, se não existir. Usa o conjunto dos números com vértice, construído a partir da lista de vértices na primeira procura depois de a tabela de acesso direto crescer, e o seu resumo com um bit por palavra não vazia: só percorre as palavras do resumo entre pnumber e o vértice procurado, em vez de todos os números sem vértice. Um número inferior ao do primeiro vértice resolve-se logo, o que torna constantes as inserções por ordem decrescente. Sem memória para o conjunto, percorre a tabela. */
+
+static PtBiNode PrevVertex (PtDigraph pdig, unsigned int pnumber)
+{
+	PtBiNode V; BITWORD *Summary, Bits; unsigned int Words, W, S;
+
+	if (pdig->Head == NULL || pdig->Head->Number >= pnumber) return NULL;
+
+	Words = BIT_WORDS (pdig->IndexSize);
+	if (pdig->Present == NULL && (pdig->Present = (BITWORD *) calloc (Words + BIT_WORDS (Words), sizeof (BITWORD))) != NULL)
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+		{ BIT_SET (pdig->Present, V->Number); BIT_SET (pdig->Present + Words, V->Number / WORD_BITS); }
+
+	if (pdig->Present == NULL)
+	{			/* sem memória: percorrer a tabela para baixo */
+		for (V = NULL; V == NULL; ) V = pdig->Index[--pnumber];
+		return V;
+	}
+
+	Summary = pdig->Present + Words;
+	W = pnumber / WORD_BITS;
+	if ((Bits = pdig->Present[W] & ((1UL << (pnumber % WORD_BITS)) - 1)) == 0)
+	{			/* palavra anterior não vazia, pelo resumo; existe, dado que o primeiro vértice é inferior */
+		S = W / WORD_BITS;
+		for (Bits = Summary[S] & ((1UL << (W % WORD_BITS)) - 1); Bits == 0; ) Bits = Summary[--S];
+		W = S * WORD_BITS + (WORD_BITS - 1 - __builtin_clzl (Bits));
+		Bits = pdig->Present[W];
+	}
+	return pdig->Index[W * WORD_BITS + (WORD_BITS - 1 - __builtin_clzl (Bits))];
+}
+
+/* Função que garante que a tabela de acesso direto tem uma entrada para o número pnumber, duplicando a sua capacidade sempre que necessário. Devolve OK ou NO_MEM, caso não consiga aumentá-la por falta de memória. */
+
+static int GrowIndex (PtDigraph pdig, unsigned int pnumber)
+{
+	PtBiNode *Index; struct listshare **Share; unsigned int Size, I;
+
+	if (pnumber < pdig->IndexSize) return OK;
+	if (pnumber == UINT_MAX) return NO_MEM;
+
+	for (Size = pdig->IndexSize > 0 ? pdig->IndexSize : 16; Size <= pnumber; Size *= 2)
+		if (Size > UINT_MAX / 2) { Size = pnumber + 1; break; }
+
+	if (pdig->Share != NULL)
+	{				/* a tabela de partilhas acompanha a tabela de acesso direto */
+		if ((Share = (struct listshare **) realloc (pdig->Share, Size * sizeof (struct listshare *))) == NULL)
+			return NO_MEM;
+		for (I = pdig->IndexSize; I < Size; I++) Share[I] = NULL;
+		pdig->Share = Share;
+	}
+
+	if ((Index = (PtBiNode *) realloc (pdig->Index, Size * sizeof (PtBiNode))) == NULL)
+		return NO_MEM;
+	for (I = pdig->IndexSize; I < Size; I++) Index[I] = NULL;	/* números sem vértice */
+
+	pdig->Index = Index;
+	pdig->IndexSize = Size;
+	free (pdig->Present); pdig->Present = NULL;	/* reconstruído na próxima inserção de um vértice */
+	return OK;
+}
+
+/* Algoritmo de Dijkstra que determina os caminhos mais curtos de todos os vértices alcancáveis pelo vértice pvertice, no contexto de consulta pquery (ou num contexto temporário, se for NULL). Esta versão assume que as sequências foram previamente validadas. */
+
+static int DijkstraPQueue (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pcost[], PtQuery pquery)
+{
+	PtBiNode V; PtQuery Query = pquery;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+				/* verificar se o vértice de partida existe */
+	if ((V = VertexPosition (pdig, pv)) == NULL) return NO_VERTEX;
+
+				/* preparar a fila com prioridade e as marcas do contexto */
+	if (Query == NULL) { if ((Query = QueryCreate (pdig)) == NULL) return NO_MEM; }
+	else if (QueryBegin (Query, pdig, 1, pdig->PQueueKind) != OK) return NO_MEM;
+
+	DijkstraSearch (pdig, V, Query);
+	DijkstraResult (pdig, Query, pvpred, pcost);
+
+	if (Query != pquery) QueryDestroy (&Query);
+	return OK;
+}
+
+/* Pesquisa de Dijkstra a partir do vértice psource, no contexto pquery já preparado por QueryBegin. Só os vértices alcançados são tocados: as marcas da época atual distinguem os vértices alcançados (Epoch), cujo predecessor e custo no contexto são válidos, dos já conhecidos (Epoch+1). Várias pesquisas, com contextos diferentes, podem decorrer em simultâneo sobre o mesmo dígrafo/grafo. */
+
+static void DijkstraSearch (PtDigraph pdig, PtBiNode psource, PtQuery pquery)
+{
+	PtBiNode V, E; int Cost; VERTEX Elem;
+	unsigned int *Mark = pquery->Side[0].Mark, Epoch = pquery->Epoch;
+
+		/* inserção preguiçosa: a fila começa só com o vértice de partida */
+	Mark[psource->Number] = Epoch;
+	pquery->Side[0].Pred[psource->Number] = 0; pquery->Side[0].Cost[psource->Number] = 0;
+	Elem.Vertex = psource->Number; Elem.Cost = 0;
+	PQueueInsert (pquery->Side[0].PQueue, &Elem);
+
+	while (!PQueueIsEmpty (pquery->Side[0].PQueue))
+	{		/* retirar o elemento da fila e pesquisar o vértice no grafo */
+		PQueueDeleteMin (pquery->Side[0].PQueue, &Elem);
+		V = pdig->Index[Elem.Vertex];
+		Mark[V->Number] = Epoch + 1;	/* marcar o vértice como conhecido */
+
+		for (E = V->PtAdj; E != NULL; E = E->PtNext)
+			if (Mark[E->Number] != Epoch + 1)	/* não processar vértices conhecidos */
+			{	/* calcular o custo desta travessia */
+				Cost = pquery->Side[0].Cost[V->Number] + E->Elem.Edge.Cost;
+				if (Mark[E->Number] != Epoch || Cost < pquery->Side[0].Cost[E->Number])
+				{	/* atualizar o percurso e o custo desta travessia */	
+					Mark[E->Number] = Epoch;
+					pquery->Side[0].Pred[E->Number] = V->Number;
+					pquery->Side[0].Cost[E->Number] = Cost;
+				/* atualizar o elemento na fila ou inseri-lo se ainda não foi alcançado */
+					Elem.Vertex = E->Number; Elem.Cost = Cost;
+					if (PQueueContains (pquery->Side[0].PQueue, E->Number) == OK) PQueueDecrease (pquery->Side[0].PQueue, &Elem);
+					else PQueueInsert (pquery->Side[0].PQueue, &Elem);
+				}
+			}
+	}
+}
+
+/* Função que copia o resultado da última pesquisa de Dijkstra ou de Bellman-Ford no contexto pquery para as sequências pvpred e pcost (indexadas pelo número do vértice menos 1), com predecessor 0 e custo INT_MAX nos vértices não alcançados. */
+
+static void DijkstraResult (PtDigraph pdig, PtQuery pquery, unsigned int pvpred[], int pcost[])
+{
+	PtBiNode V;
+
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+		if (pquery->Side[0].Mark[V->Number] >= pquery->Epoch)
+		{
+			pvpred[V->Number-1] = pquery->Side[0].Pred[V->Number];
+			pcost[V->Number-1] = pquery->Side[0].Cost[V->Number];
+		}
+		else { pvpred[V->Number-1] = 0; pcost[V->Number-1] = INT_MAX; }
+}
+
+/* Algoritmo de Bellman-Ford com fila (SPFA) a partir do vértice psource, no contexto pquery preparado com dois sentidos. A fila é uma fila dupla circular sobre a fronteira do contexto, com a heurística SLF: um vértice cujo custo é menor do que o da cabeça entra à cabeça, senão entra na cauda. Side[1] guarda a marca de vértice na fila (Mark) e o número de arcos do caminho atual (Pred); um caminho com tantos arcos como vértices contém um ciclo negativo, o que é detetado logo na relaxação que o cria. Devolve OK ou NEG_CYCLE. */
+
+static int SPFASearch (PtDigraph pdig, PtBiNode psource, PtQuery pquery)
+{
+	struct search *Side = &pquery->Side[0]; PtBiNode V, E, *Deque = pquery->Frontier;
+	unsigned int *InQueue = pquery->Side[1].Mark, *Length = pquery->Side[1].Pred;
+	unsigned int Epoch = pquery->Epoch, Size = Side->Capacity, Head = 0, Count = 1; int Cost;
+
+	Side->Mark[psource->Number] = Epoch;
+	Side->Pred[psource->Number] = 0; Side->Cost[psource->Number] = 0;
+	Length[psource->Number] = 0;
+	InQueue[psource->Number] = Epoch; Deque[0] = psource;
+
+	while (Count > 0)
+	{		/* retirar o vértice da cabeça da fila */
+		V = Deque[Head]; Head = (Head + 1) % Size; Count--;
+		InQueue[V->Number] = 0;
+
+		for (E = V->PtAdj; E != NULL; E = E->PtNext)
+		{
+			Cost = Side->Cost[V->Number] + E->Elem.Edge.Cost;
+			if (Side->Mark[E->Number] != Epoch || Cost < Side->Cost[E->Number])
+			{	/* atualizar o percurso e o custo desta travessia */
+				Side->Mark[E->Number] = Epoch;
+				Side->Pred[E->Number] = V->Number; Side->Cost[E->Number] = Cost;
+				if ((Length[E->Number] = Length[V->Number] + 1) >= pdig->NVertexes) return NEG_CYCLE;
+
+				if (InQueue[E->Number] != Epoch)
+				{	/* SLF: à cabeça se for menor do que o custo da cabeça */
+					InQueue[E->Number] = Epoch;
+					if (Count > 0 && Cost < Side->Cost[Deque[Head]->Number])
+					{ Head = (Head + Size - 1) % Size; Deque[Head] = pdig->Index[E->Number]; }
+					else Deque[(Head + Count) % Size] = pdig->Index[E->Number];
+					Count++;
+				}
+			}
+		}
+	}
+
+	return OK;
+}
+
+/* Função que devolve em porder a ordem topológica do dígrafo pdig (os números dos seus NVertexes vértices), calculando-a com o algoritmo de Kahn sobre uma cópia dos semigraus incidentes se o dígrafo mudou desde a última ordenação. A ordem fica em cache no dígrafo, protegida pelo mesmo mutex do índice inverso. Devolve OK, NO_DAG (se houver um ciclo) ou NO_MEM. */
+
+static int TopologicalOrder (PtDigraph pdig, unsigned int **porder)
+{
+	PtBiNode V, E; unsigned int *Order, *InDeg, Head, Tail = 0; int Status;
+
+	pthread_mutex_lock (&pdig->CacheLock);
+	if (pdig->Order == NULL || pdig->OrderVersion != pdig->Version)
+	{
+		free (pdig->Order); pdig->Order = NULL;
+		Order = (unsigned int *) malloc (pdig->NVertexes * sizeof (unsigned int));
+		InDeg = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int));
+		if (Order == NULL || InDeg == NULL)
+		{
+			free (Order); free (InDeg);
+			pthread_mutex_unlock (&pdig->CacheLock); return NO_MEM;
+		}
+
+				/* a ordem serve de fila: começa pelos vértices sem arcos incidentes */
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+			if ((InDeg[V->Number] = V->Elem.Vertex.InDeg) == 0) Order[Tail++] = V->Number;
+
+		for (Head = 0; Head < Tail; Head++)
+			for (E = pdig->Index[Order[Head]]->PtAdj; E != NULL; E = E->PtNext)
+				if (--InDeg[E->Number] == 0) Order[Tail++] = E->Number;
+
+		free (InDeg);
+		pdig->Order = Order; pdig->OrderVersion = pdig->Version;
+		pdig->OrderStatus = Tail == pdig->NVertexes ? OK : NO_DAG;	/* vértices por ordenar estão num ciclo */
+	}
+
+	*porder = pdig->Order; Status = pdig->OrderStatus;
+	pthread_mutex_unlock (&pdig->CacheLock);
+	return Status;
+}
+
+/* Caminhos mais curtos (plongest a 0) ou mais longos (plongest a 1) a partir do vértice pv num dígrafo acíclico, relaxando os arcos pela ordem topológica, em tempo linear. As sequências pvpred e pvcost servem diretamente de estado da pesquisa. */
+
+static int DAGPaths (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[], unsigned int plongest)
+{
+	PtBiNode V, E; unsigned int *Order, I; int Cost, Error;
+
+	if (pdig == NULL) return NO_DIGRAPH;
+	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pvpred == NULL || pvcost == NULL) return NULL_PTR;
+	if (VertexPosition (pdig, pv) == NULL) return NO_VERTEX;
+
+	if ((Error = TopologicalOrder (pdig, &Order)) != OK) return Error;
+
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+	{ pvpred[V->Number-1] = 0; pvcost[V->Number-1] = INT_MAX; }
+	pvcost[pv-1] = 0;
+
+	for (I = 0; I < pdig->NVertexes; I++)
+	{		/* os vértices anteriores a pv na ordem não são alcançáveis */
+		V = pdig->Index[Order[I]];
+		if (pvcost[V->Number-1] == INT_MAX) continue;
+
+		for (E = V->PtAdj; E != NULL; E = E->PtNext)
+		{
+			Cost = pvcost[V->Number-1] + E->Elem.Edge.Cost;
+			if (pvcost[E->Number-1] == INT_MAX || (plongest ? Cost > pvcost[E->Number-1] : Cost < pvcost[E->Number-1]))
+			{
+				pvcost[E->Number-1] = Cost; pvpred[E->Number-1] = V->Number;
+			}
+		}
+	}
+
+	return OK;
+}
+
+/* Algoritmo de Prim, repetido a partir de cada vértice ainda fora da floresta, que coloca em ptree as pntree arestas da floresta geradora mínima do dígrafo/grafo pdig. Num dígrafo, os arcos são percorridos nos dois sentidos (listas de arcos incidentes ou índice inverso). Como as chaves não são monótonas, usa sempre o amontoado binário indexado. Devolve OK ou NO_MEM. */
+
+static int PrimForest (PtDigraph pdig, struct arc *ptree, unsigned int *pntree)
+{
+	struct reverse *Rev = NULL; PtPQueue PQueue; PtBiNode Root, V, E; VERTEX Elem;
+	unsigned char *State; unsigned int *Pred, A; int *Key;
+
+	if (pdig->Type && !pdig->Incoming && (Rev = ReverseIndex (pdig)) == NULL) return NO_MEM;
+
+	PQueue = PQueueCreateKind (pdig->IndexSize, PQUEUE_BINARY);
+	State = (unsigned char *) calloc (pdig->IndexSize, sizeof (unsigned char));	/* 0 fora, 1 na fila, 2 na árvore */
+	Pred = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int));
+	Key = (int *) malloc (pdig->IndexSize * sizeof (int));
+	if (PQueue == NULL || State == NULL || Pred == NULL || Key == NULL)
+	{
+		if (PQueue != NULL) PQueueDestroy (&PQueue);
+		free (State); free (Pred); free (Key);
+		return NO_MEM;
+	}
+
+	for (Root = pdig->Head; Root != NULL; Root = Root->PtNext)
+	{
+		if (State[Root->Number] != 0) continue;	/* já pertence a uma árvore */
+
+		PrimRelax (PQueue, State, Pred, Key, 0, Root->Number, 0);
+		while (!PQueueIsEmpty (PQueue))
+		{	/* juntar à árvore o vértice mais barato da fronteira */
+			PQueueDeleteMin (PQueue, &Elem);
+			V = pdig->Index[Elem.Vertex];
+			State[V->Number] = 2;
+			if (Pred[V->Number] != 0)
+			{
+				ptree[*pntree].V1 = Pred[V->Number]; ptree[*pntree].V2 = V->Number;
+				ptree[*pntree].Cost = Key[V->Number]; (*pntree)++;
+			}
+
+			for (E = V->PtAdj; E != NULL; E = E->PtNext)
+				PrimRelax (PQueue, State, Pred, Key, V->Number, E->Number, E->Elem.Edge.Cost);
+			if (pdig->Type && Rev == NULL)
+				for (E = V->Elem.Vertex.PtIn; E != NULL; E = E->PtNext)
+					PrimRelax (PQueue, State, Pred, Key, V->Number, E->Number, E->Elem.Edge.Cost);
+			else if (pdig->Type)
+				for (A = Rev->Offset[V->Number]; A < Rev->Offset[V->Number+1]; A++)
+					PrimRelax (PQueue, State, Pred, Key, V->Number, Rev->Source[A], Rev->Cost[A]);
+		}
+	}
+
+	PQueueDestroy (&PQueue);
+	free (State); free (Pred); free (Key);
+	return OK;
+}
+
+/* Relaxação de Prim da aresta pv-pw de custo pcost: o vértice pw, se ainda não está na árvore, entra na fila ou baixa a sua chave. */
+
+static void PrimRelax (PtPQueue ppqueue, unsigned char *pstate, unsigned int *ppred, int *pkey, unsigned int pv, unsigned int pw, int pcost)
+{
+	VERTEX Elem;
+
+	if (pstate[pw] == 2 || (pstate[pw] == 1 && pcost >= pkey[pw])) return;
+
+	ppred[pw] = pv; pkey[pw] = pcost;
+	Elem.Vertex = pw; Elem.Cost = pcost;
+	if (pstate[pw] == 1) PQueueDecrease (ppqueue, &Elem);
+	else { PQueueInsert (ppqueue, &Elem); pstate[pw] = 1; }
+}
+
+/* Algoritmo de Kruskal, que coloca em ptree as pntree arestas da floresta geradora mínima do dígrafo/grafo pdig: as arestas (num grafo, uma por par de arcos) são ordenadas pelo custo com uma ordenação radix paralela e juntadas por ordem se ligarem dois conjuntos diferentes da partição união-procura. Devolve OK ou NO_MEM. */
+
+static int KruskalForest (PtDigraph pdig, struct arc *ptree, unsigned int *pntree)
+{
+	struct arc *Edges; PtBiNode V, E; unsigned int *Parent, NEdges = 0, A;
+	unsigned char *Rank;
+
+	Edges = (struct arc *) malloc ((pdig->NEdges + 1) * sizeof (struct arc));
+	Parent = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int));
+	Rank = (unsigned char *) calloc (pdig->IndexSize, sizeof (unsigned char));
+	if (Edges == NULL || Parent == NULL || Rank == NULL) { free (Edges); free (Parent); free (Rank); return NO_MEM; }
+
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+	{
+		Parent[V->Number] = V->Number;	/* cada vértice começa sozinho no seu conjunto */
+		for (E = V->PtAdj; E != NULL; E = E->PtNext)
+			if (pdig->Type || V->Number < E->Number)
+			{ Edges[NEdges].V1 = V->Number; Edges[NEdges].V2 = E->Number; Edges[NEdges++].Cost = E->Elem.Edge.Cost; }
+	}
+
+	if (SortArcsByCost (Edges, NEdges) != OK) { free (Edges); free (Parent); free (Rank); return NO_MEM; }
+
+	for (A = 0; A < NEdges && *pntree < pdig->NVertexes - 1; A++)
+		if (UnionSets (Parent, Rank, Edges[A].V1, Edges[A].V2))
+			ptree[(*pntree)++] = Edges[A];
+
+	free (Edges); free (Parent); free (Rank);
+	return OK;
+}
+
+/* Função que ordena, de forma estável, os pnarcs arcos de parcs pelo custo, com uma ordenação radix LSD de RADIX_BITS bits por passagem. Cada passagem conta os dígitos e distribui os arcos em paralelo, com um fio por processador e pelo menos RADIX_MIN arcos por fio; as passagens em que todos os arcos têm o mesmo dígito são saltadas. Devolve OK ou NO_MEM. */
+
+static int SortArcsByCost (struct arc *parcs, unsigned int pnarcs)
+{
+	struct radixjob *Jobs; struct arc *Tmp, *From = parcs, *To;
+	unsigned int NJobs, J, D, Shift, Offset; long NProc;
+
+	if (pnarcs < 2) return OK;
+
+	NProc = sysconf (_SC_NPROCESSORS_ONLN);
+	NJobs = pnarcs / RADIX_MIN + 1;
+	if (NProc > 0 && NJobs > (unsigned int) NProc) NJobs = (unsigned int) NProc;
+	if (NProc <= 0) NJobs = 1;
+
+	Tmp = (struct arc *) malloc (pnarcs * sizeof (struct arc));
+	Jobs = (struct radixjob *) malloc (NJobs * sizeof (struct radixjob));
+	if (Tmp == NULL || Jobs == NULL) { free (Tmp); free (Jobs); return NO_MEM; }
+	To = Tmp;
+
+	for (Shift = 0; Shift < CHAR_BIT * sizeof (unsigned int); Shift += RADIX_BITS)
+	{
+		for (J = 0; J < NJobs; J++)
+		{	/* cada fio fica com uma fatia contígua, o que mantém a estabilidade */
+			Jobs[J].From = From; Jobs[J].To = To; Jobs[J].Shift = Shift;
+			Jobs[J].Begin = (unsigned int) ((double) pnarcs * J / NJobs);
+			Jobs[J].End = (unsigned int) ((double) pnarcs * (J + 1) / NJobs);
+		}
+		RunRadixJobs (Jobs, NJobs, RadixCount);
+
+		for (D = 0; D < RADIX_DIGITS; D++)
+		{	/* passagem inútil: todos os arcos com o mesmo dígito */
+			for (J = 0, Offset = 0; J < NJobs; J++) Offset += Jobs[J].Count[D];
+			if (Offset == pnarcs) break;
+		}
+		if (D < RADIX_DIGITS) continue;
+
+				/* posições: por dígito e, dentro de cada dígito, por fio */
+		for (D = 0, Offset = 0; D < RADIX_DIGITS; D++)
+			for (J = 0; J < NJobs; J++)
+			{ unsigned int Count = Jobs[J].Count[D]; Jobs[J].Count[D] = Offset; Offset += Count; }
+
+		RunRadixJobs (Jobs, NJobs, RadixScatter);
+		To = From; From = Jobs[0].To;
+	}
+
+	if (From != parcs) memcpy (parcs, From, pnarcs * sizeof (struct arc));
+	free (Tmp); free (Jobs);
+	return OK;
+}
+
+/* Função que executa as pnjobs partes de uma passagem da ordenação radix com a função pfunction, uma por fio; a primeira, e qualquer outra cujo fio não possa ser criado, é executada pelo próprio fio que chama. */
+
+static void RunRadixJobs (struct radixjob *pjobs, unsigned int pnjobs, void *(*pfunction) (void *))
+{
+	pthread_t *Threads; unsigned char *Created; unsigned int J;
+
+	Threads = (pthread_t *) malloc (pnjobs * sizeof (pthread_t));
+	Created = (unsigned char *) calloc (pnjobs, sizeof (unsigned char));
+	if (Threads != NULL && Created != NULL)
+		for (J = 1; J < pnjobs; J++)
+			Created[J] = pthread_create (&Threads[J], NULL, pfunction, &pjobs[J]) == 0;
+
+	for (J = 0; J < pnjobs; J++)
+		if (Created == NULL || !Created[J]) pfunction (&pjobs[J]);
+	for (J = 1; J < pnjobs; J++)
+		if (Created != NULL && Created[J]) pthread_join (Threads[J], NULL);
+
+	free (Threads); free (Created);
+}
+
+/* Contagem dos dígitos da fatia de uma parte da ordenação radix. */
+
+static void *RadixCount (void *pjob)
+{
+	struct radixjob *Job = (struct radixjob *) pjob; unsigned int A;
+
+	memset (Job->Count, 0, sizeof (Job->Count));
+	for (A = Job->Begin; A < Job->End; A++)
+		Job->Count[(COST_KEY (Job->From[A].Cost) >> Job->Shift) & (RADIX_DIGITS - 1)]++;
+	return NULL;
+}
+
+/* Distribuição da fatia de uma parte da ordenação radix pelas posições já calculadas. */
+
+static void *RadixScatter (void *pjob)
+{
+	struct radixjob *Job = (struct radixjob *) pjob; unsigned int A;
+
+	for (A = Job->Begin; A < Job->End; A++)
+		Job->To[Job->Count[(COST_KEY (Job->From[A].Cost) >> Job->Shift) & (RADIX_DIGITS - 1)]++] = Job->From[A];
+	return NULL;
+}
+
+/* Procura do representante do conjunto do elemento pe na partição união-procura pparent, com divisão dos caminhos a meio. */
+
+static unsigned int FindSet (unsigned int *pparent, unsigned int pe)
+{
+	while (pparent[pe] != pe)
+	{
+		pparent[pe] = pparent[pparent[pe]];
+		pe = pparent[pe];
+	}
+	return pe;
+}
+
+/* União, por ordem, dos conjuntos dos elementos pe1 e pe2 na partição união-procura pparent com as ordens prank. Devolve 1 se os conjuntos eram diferentes ou 0 se já eram o mesmo. */
+
+static unsigned int UnionSets (unsigned int *pparent, unsigned char *prank, unsigned int pe1, unsigned int pe2)
+{
+	unsigned int R1 = FindSet (pparent, pe1), R2 = FindSet (pparent, pe2);
+
+	if (R1 == R2) return 0;
+
+	if (prank[R1] < prank[R2]) pparent[R1] = R2;
+	else if (prank[R1] > prank[R2]) pparent[R2] = R1;
+	else { pparent[R2] = R1; prank[R1]++; }
+	return 1;
+}
+
+/* Função que indica se a partição das componentes do dígrafo pdig pode ser mantida na próxima inserção: a manutenção está ligada e a partição corresponde à versão atual. */
+
+static unsigned int PartitionValid (PtDigraph pdig)
+{
+	return pdig->Connectivity && pdig->Parent != NULL && pdig->PartitionVersion == pdig->Version;
+}
+
+/* Função que aumenta a partição das componentes do dígrafo pdig até à capacidade da tabela de acesso direto. Devolve OK ou NO_MEM. */
+
+static int GrowPartition (PtDigraph pdig)
+{
+	unsigned int *Parent; unsigned char *Rank;
+
+	if (pdig->PartitionSize >= pdig->IndexSize) return OK;
+
+	if ((Parent = (unsigned int *) realloc (pdig->Parent, pdig->IndexSize * sizeof (unsigned int))) != NULL) pdig->Parent = Parent;
+	if ((Rank = (unsigned char *) realloc (pdig->Rank, pdig->IndexSize * sizeof (unsigned char))) != NULL) pdig->Rank = Rank;
+	if (Parent == NULL || Rank == NULL) return NO_MEM;
+
+	pdig->PartitionSize = pdig->IndexSize;
+	return OK;
+}
+
+/* Função que garante que a partição união-procura das componentes (fracamente) conexas do dígrafo/grafo pdig corresponde à versão atual, reconstruindo-a a partir de todas as arestas se o dígrafo mudou sem a manter (remoções ou inserções sem manutenção). Tem de ser chamada com o mutex das caches. Devolve OK ou NO_MEM. */
+
+static int Partition (PtDigraph pdig)
+{
+	PtBiNode V, E;
+
+	if (pdig->Parent != NULL && pdig->PartitionVersion == pdig->Version) return OK;
+
+	if (GrowPartition (pdig) != OK) return NO_MEM;
+
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+	{ pdig->Parent[V->Number] = V->Number; pdig->Rank[V->Number] = 0; }
+
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+		for (E = V->PtAdj; E != NULL; E = E->PtNext)
+			if (pdig->Type || V->Number < E->Number) UnionSets (pdig->Parent, pdig->Rank, V->Number, E->Number);
+
+	pdig->PartitionVersion = pdig->Version;
+	return OK;
+}
+
+/* Função que prepara o contexto pquery para uma nova consulta ao dígrafo/grafo pdig com pnsides sentidos de pesquisa (1 ou 2) e filas com prioridade do tipo pkind: cria ou aumenta as sequências de cada sentido se o dígrafo/grafo tiver crescido, recria ou esvazia as filas com prioridade e avança a época, o que invalida de uma só vez todas as marcas anteriores. As marcas só são apagadas quando a época dá a volta. Devolve OK ou NO_MEM. */
+
+static int QueryBegin (PtQuery pquery, PtDigraph pdig, unsigned int pnsides, unsigned int pkind)
+{
+	struct search *Side; unsigned int *Mark, *Pred, S, Capacity = pdig->IndexSize > 0 ? pdig->IndexSize : 1;
+	int *Cost; PtBiNode *Frontier;
+
+	for (S = 0; S < pnsides; S++)
+	{
+		Side = &pquery->Side[S];
+		if (Capacity > Side->Capacity)
+		{		/* aumentar as sequências indexadas pelo número do vértice */
+			if ((Mark = (unsigned int *) realloc (Side->Mark, Capacity * sizeof (unsigned int))) != NULL) Side->Mark = Mark;
+			if ((Pred = (unsigned int *) realloc (Side->Pred, Capacity * sizeof (unsigned int))) != NULL) Side->Pred = Pred;
+			if ((Cost = (int *) realloc (Side->Cost, Capacity * sizeof (int))) != NULL) Side->Cost = Cost;
+			if (Mark == NULL || Pred == NULL || Cost == NULL) return NO_MEM;
+			if (S == 0)	/* a fronteira acompanha a pesquisa direta */
+			{
+				if ((Frontier = (PtBiNode *) realloc (pquery->Frontier, Capacity * sizeof (PtBiNode))) == NULL) return NO_MEM;
+				pquery->Frontier = Frontier;
+			}
+
+			memset (Mark + Side->Capacity, 0, (Capacity - Side->Capacity) * sizeof (unsigned int));
+			Side->Capacity = Capacity;
+			if (Side->PQueue != NULL) PQueueDestroy (&Side->PQueue);
+		}
+
+		if (Side->PQueue != NULL && Side->PQueueKind != pkind) PQueueDestroy (&Side->PQueue);
+		if (Side->PQueue == NULL)
+		{
+			if ((Side->PQueue = PQueueCreateKind (Side->Capacity, pkind)) == NULL) return NO_MEM;
+			Side->PQueueKind = pkind;
+		}
+		else PQueueClear (Side->PQueue);
+	}
 
-    	/* Verifica se o digrafo est vazio */
-    	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
+	if (pquery->Epoch >= UINT_MAX - 3)	/* a época deu a volta: apagar as marcas */
+	{
+		for (S = 0; S < 2; S++)
+			if (pquery->Side[S].Mark != NULL)
+				memset (pquery->Side[S].Mark, 0, pquery->Side[S].Capacity * sizeof (unsigned int));
+		pquery->Epoch = 0;
+	}
+	pquery->Epoch += 2;	/* nova época: marcas anteriores ficam inválidas */
 
-    	/* Verifica se o ponteiro para a lista  nulo */
-    	if ((pdig->Head->PtElem) == NULL) return NULL_PTR;
+	return OK;
+}
 
-    	/* Verifica se existe memria no digrafo */
-    	if ((pvlist = (unsigned int *) malloc(pdig->NVertexes * sizeof(unsigned int))) == NULL) return NO_MEM;
+/* Função de comparação de números de vértice para qsort. */
 
-	/* Verifica se o digrafo  fortemente conexo */
-	for (Vt = pdig->Head; Vt != NULL; Vt = Vt->PtNext){
-		Reach(pdig, Vt->Number , pvlist);
-		if(pdig->NVertexes != pvlist[0]){
-			*pstrong = 0;
-			return OK;
+static int CompareNumbers (const void *pa, const void *pb)
+{
+	unsigned int A = *(const unsigned int *) pa, B = *(const unsigned int *) pb;
+
+	return A < B ? -1 : A > B;
+}
+
+/* Função executada por cada fio de DigraphAllPairs: cria o seu próprio contexto de consulta e, enquanto houver vértices de partida por atribuir, retira o seguinte e preenche a sua linha das matrizes. */
+
+static void *AllPairsWorker (void *pjob)
+{
+	struct allpairs *Job = (struct allpairs *) pjob; PtDigraph Digraph = Job->Digraph;
+	PtQuery Query; PtBiNode Source; size_t Row;
+
+	if ((Query = QueryCreate (Digraph)) == NULL)
+	{
+		pthread_mutex_lock (&Job->Lock);
+		Job->Error = NO_MEM;
+		pthread_mutex_unlock (&Job->Lock);
+		return NULL;
+	}
+
+	for ( ; ; )
+	{
+		pthread_mutex_lock (&Job->Lock);	/* atribuir o próximo vértice de partida */
+		if ((Source = Job->Next) != NULL) Job->Next = Source->PtNext;
+		pthread_mutex_unlock (&Job->Lock);
+		if (Source == NULL) break;
+
+		Row = (size_t) (Source->Number - 1) * Job->Dim;
+		QueryBegin (Query, Digraph, 1, Digraph->PQueueKind);	/* o dígrafo não cresce: não falha */
+		DijkstraSearch (Digraph, Source, Query);
+		DijkstraResult (Digraph, Query, Job->Pred + Row, Job->Cost + Row);
+	}
+
+	QueryDestroy (&Query);
+	return NULL;
+}
+
+/* Função que lê um número inteiro (com sinal opcional) da sequência de carateres entre *ppos e pend, ignorando os separadores anteriores, e avança *ppos. Devolve 1 se leu um número e 0 caso contrário, incluindo um número que não cabe num long. */
+
+static int ParseNumber (char **ppos, char *pend, long *pvalue)
+{
+	char *Pos = *ppos; long Value = 0; int Negative = 0;
+
+	while (Pos < pend && (*Pos == ' ' || *Pos == '\t' || *Pos == '\n' || *Pos == '\r')) Pos++;
+	if (Pos < pend && (*Pos == '-' || *Pos == '+')) Negative = *Pos++ == '-';
+	if (Pos == pend || *Pos < '0' || *Pos > '9') return 0;
+
+	while (Pos < pend && *Pos >= '0' && *Pos <= '9')
+	{
+		if (Value > (LONG_MAX - (*Pos - '0')) / 10) return 0;	/* transbordo */
+		Value = 10 * Value + (*Pos++ - '0');
+	}
+
+	*pvalue = Negative ? -Value : Value;
+	*ppos = Pos;
+	return 1;
+}
+
+/* Função que insere em bloco os pnarcs arcos da sequência parcs (num grafo, cada aresta tem de estar nos dois sentidos) e atualiza o número de arestas. Os arcos são validados antes de qualquer alteração do dígrafo/grafo, ordenados por (emergente, incidente) e ligados numa só passagem por cada lista de adjacências. Devolve OK, NO_VERTEX, REP_EDGE (aresta repetida ou lacete) ou NO_MEM. */
+
+static int BulkInsertEdges (PtDigraph pdig, struct arc *parcs, unsigned int pnarcs)
+{
+	PtBiNode V, E, Prev; unsigned int *Rank, A, R, Linked = 0; int Error = OK;
+
+	if (pnarcs == 0) return OK;
+
+					/* validar os vértices e os lacetes */
+	for (A = 0; A < pnarcs; A++)
+	{
+		if (VertexPosition (pdig, parcs[A].V1) == NULL || VertexPosition (pdig, parcs[A].V2) == NULL)
+			return NO_VERTEX;
+		if (parcs[A].V1 == parcs[A].V2) return REP_EDGE;
+	}
+
+					/* ordenar os arcos pela posição dos vértices na lista de vértices */
+	if ((Rank = (unsigned int *) malloc (pdig->IndexSize * sizeof (unsigned int))) == NULL) return NO_MEM;
+	for (V = pdig->Head, R = 0; V != NULL; V = V->PtNext, R++) Rank[V->Number] = R;
+	if (SortArcs (pdig, parcs, pnarcs, Rank) != OK) { free (Rank); return NO_MEM; }
+	free (Rank);
+
+					/* detetar arcos repetidos na sequência ou já existentes */
+	for (A = 0, E = NULL; A < pnarcs; A++)
+	{
+		if (A > 0 && parcs[A].V1 == parcs[A-1].V1 && parcs[A].V2 == parcs[A-1].V2) return REP_EDGE;
+		if (A == 0 || parcs[A].V1 != parcs[A-1].V1) E = VertexPosition (pdig, parcs[A].V1)->PtAdj;
+		while (E != NULL && E->Number < parcs[A].V2) E = E->PtNext;
+		if (E != NULL && E->Number == parcs[A].V2) return REP_EDGE;
+	}
+
+					/* ligar os arcos, fundindo-os com as listas de adjacências ordenadas */
+	for (A = 0, V = Prev = E = NULL; A < pnarcs && Error == OK; A++)
+	{
+		if (A == 0 || parcs[A].V1 != parcs[A-1].V1)
+		{ V = VertexPosition (pdig, parcs[A].V1); Prev = NULL; E = V->PtAdj; }
+
+		while (E != NULL && E->Number < parcs[A].V2) { Prev = E; E = E->PtNext; }
+		if ((Error = LinkEdge (pdig, V, Prev, VertexPosition (pdig, parcs[A].V2), parcs[A].Cost)) == OK)
+		{
+			Prev = Prev == NULL ? V->PtAdj : Prev->PtNext;	/* o novo arco */
+			Linked++;
+		}
+	}
+
+	pdig->NEdges += pdig->Type ? Linked : Linked / 2;	/* num grafo, uma aresta por cada dois arcos */
+	return Error;
+}
+
+/* Função que ordena os pnarcs arcos da sequência parcs por (emergente, incidente), com uma ordenação radix de duas passagens de contagem estáveis, cujos dígitos são as posições prank dos vértices (indexadas pelo número). Devolve OK ou NO_MEM. */
+
+static int SortArcs (PtDigraph pdig, struct arc *parcs, unsigned int pnarcs, unsigned int *prank)
+{
+	struct arc *Tmp; unsigned int *Count, A, R, Pass, Key;
+
+	Tmp = (struct arc *) malloc (pnarcs * sizeof (struct arc));
+	Count = (unsigned int *) malloc ((pdig->NVertexes + 1) * sizeof (unsigned int));
+	if (Tmp == NULL || Count == NULL) { free (Tmp); free (Count); return NO_MEM; }
+
+	for (Pass = 0; Pass < 2; Pass++)	/* primeiro pelo incidente, depois pelo emergente */
+	{
+		memset (Count, 0, (pdig->NVertexes + 1) * sizeof (unsigned int));
+		for (A = 0; A < pnarcs; A++)
+		{
+			Key = prank[Pass ? parcs[A].V1 : parcs[A].V2];
+			Count[Key+1]++;
+		}
+		for (R = 0; R < pdig->NVertexes; R++) Count[R+1] += Count[R];
+		for (A = 0; A < pnarcs; A++)
+		{
+			Key = prank[Pass ? parcs[A].V1 : parcs[A].V2];
+			Tmp[Count[Key]++] = parcs[A];
 		}
+		memcpy (parcs, Tmp, pnarcs * sizeof (struct arc));
 	}
 
-	*pstrong = 1;
+	free (Tmp); free (Count);
+	return OK;
+}
+
+/* Função que processa um registo [pbegin, pend[ de CreateStream: uma linha vazia, um vértice isolado (v) ou uma aresta (v1 v2 custo), criando os vértices que ainda não existam. Devolve OK, NO_MEM, REP_EDGE (lacete) ou NO_FILE (registo inválido). */
+
+static int StreamRecord (PtDigraph pdig, char *pbegin, char *pend)
+{
+	char *Pos = pbegin; long Value[3]; unsigned int N; PtBiNode V1, V2; int Error;
+
+	for (N = 0; N < 3 && ParseNumber (&Pos, pend, &Value[N]); N++) ;
+	while (Pos < pend && (*Pos == ' ' || *Pos == '\t' || *Pos == '\r')) Pos++;
+	if (Pos != pend || N == 2) return NO_FILE;	/* campos a mais ou a menos */
+	if (N == 0) return OK;
+
+	if (Value[0] < 0 || Value[0] >= UINT_MAX) return NO_FILE;
+	if ((Error = StreamVertex (pdig, (unsigned int) Value[0], &V1)) != OK || N == 1) return Error;
+
+	if (Value[1] < 0 || Value[1] >= UINT_MAX || Value[2] < INT_MIN || Value[2] > INT_MAX) return NO_FILE;
+	if (Value[0] == Value[1]) return REP_EDGE;
+	if ((Error = StreamVertex (pdig, (unsigned int) Value[1], &V2)) != OK) return Error;
+
+	/* arco no fim da lista de v1 (e, num grafo, o arco inverso no fim da de v2) */
+	if ((Error = StreamArc (pdig, V1, V2, (int) Value[2])) != OK || pdig->Type) return Error;
+	return StreamArc (pdig, V2, V1, (int) Value[2]);
+}
+
+/* Função que devolve em pnode o vértice pv, criando-o se ainda não existir. O vértice é apenas registado na tabela de acesso direto, sendo a lista de vértices ligada por StreamFinish. Devolve OK ou NO_MEM. */
+
+static int StreamVertex (PtDigraph pdig, unsigned int pv, PtBiNode *pnode)
+{
+	if ((*pnode = VertexPosition (pdig, pv)) != NULL) return OK;
+
+	if (GrowIndex (pdig, pv) != OK || (*pnode = CreateBiNode (pdig, pv)) == NULL) return NO_MEM;
+	pdig->Index[pv] = *pnode;
+	pdig->NVertexes++;
 	return OK;
+}
+
+/* Função que acrescenta o arco (pv1, pv2) no fim da lista de adjacências de pv1, sem a manter ordenada. Enquanto dura a leitura, o PtPrev do primeiro arco de cada lista aponta para o último, que é o buffer de acréscimo da lista. Devolve OK ou NO_MEM. */
+
+static int StreamArc (PtDigraph pdig, PtBiNode pv1, PtBiNode pv2, int pcost)
+{
+	PtBiNode Node;
+
+	if ((Node = CreateBiNode (pdig, pv2->Number)) == NULL) return NO_MEM;
+	Node->Elem.Edge.Cost = pcost;	/* armazena o custo da aresta */
+	if (pcost < 0) pdig->NNegative++;
+	Node->PtAdj = pv2;
+
+	if (pv1->PtAdj == NULL) pv1->PtAdj = Node;
+	else pv1->PtAdj->PtPrev->PtNext = Node;
+	pv1->PtAdj->PtPrev = Node;	/* o novo arco passa a ser o último */
 
+	pv1->Elem.Vertex.OutDeg++;
+	pv2->Elem.Vertex.InDeg++;
+	return OK;
 }
 
-int DigraphTransitiveClosure (PtDigraph pdig)
+/* Função que conclui CreateStream: liga a lista de vértices pela ordem dos números, ordena cada lista de adjacências, refaz os seus ponteiros PtPrev e conta as arestas. Devolve OK ou REP_EDGE, se o fluxo tiver arestas repetidas. */
+
+static int StreamFinish (PtDigraph pdig)
 {
-	
-	PtBiNode aux;
-    	unsigned int i, nVertexes, *pvlist, *pdigij;
-  
-    	/* Verifica se o digrafo existe */
-    	if (pdig == NULL) return NO_DIGRAPH;
-      
-    	/* Verifica se o digrafo complementar no se encontra vazio */
-    	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
-      
-    	/* Verifica se existe memria no digrafo */
-	if ((pdigij = (unsigned int *) calloc(sizeof(unsigned int), (pdig->NVertexes + 1))) == NULL) return NO_MEM;
-
- 	VertexNumber(pdig, &nVertexes);
-    	pvlist = malloc(nVertexes * sizeof(int));
-    	aux = pdig->Head;
-    
-	/* Percorre todos os vrtices do digrafo pdig */
-    	while(aux != NULL){
-		/* Verifica os vrtices alcanveis por aux */
-        	Reach(pdig, aux->Number, pvlist);     
-        	
-		/* Percorre todos os vrtices alcanveis por aux */
-		for(i = 1; i <= pvlist[0]; i++)
-			/* Acrescenta todas as arestas que ligam diretamente o vrtice aux ao vrtice pvlist[i] */
-			InEdge(pdig, aux->Number, pvlist[i], 1);
-
-       		aux = aux->PtNext;
-    	}
-    
-    	free(pvlist);
-    	return OK;
+	PtBiNode V, E; unsigned int I, NArcs = 0;
+
+	for (I = pdig->IndexSize; I > 0; I--)
+		if ((V = pdig->Index[I-1]) != NULL)
+		{
+			V->PtNext = pdig->Head;
+			if (pdig->Head != NULL) pdig->Head->PtPrev = V;
+			pdig->Head = V;
+		}
+
+	for (V = pdig->Head; V != NULL; V = V->PtNext)
+	{
+		if (V->PtAdj == NULL) continue;
+		V->PtAdj = SortAdjacency (V->PtAdj, V->Elem.Vertex.OutDeg);
+
+		for (E = V->PtAdj, E->PtPrev = NULL; E->PtNext != NULL; E = E->PtNext)
+		{
+			if (E->PtNext->Number == E->Number) return REP_EDGE;
+			E->PtNext->PtPrev = E;
+		}
+		NArcs += V->Elem.Vertex.OutDeg;
+	}
 
+	pdig->NEdges = pdig->Type ? NArcs : NArcs / 2;	/* num grafo, uma aresta por cada dois arcos */
+	return OK;
 }
 
-/***************** Definio dos Subprogramas Internos *****************/
+/* Função que ordena pelo número do vértice incidente a lista de adjacências plist de plength arcos, ligada apenas por PtNext, com uma ordenação por fusão estável. Uma lista já ordenada (o caso habitual dos exportadores) é devolvida depois de uma só passagem. Devolve a cabeça da lista ordenada. */
+
+static PtBiNode SortAdjacency (PtBiNode plist, unsigned int plength)
+{
+	PtBiNode Left, Right, Tail, E; unsigned int I;
+
+	for (E = plist; E->PtNext != NULL && E->Number < E->PtNext->Number; E = E->PtNext) ;
+	if (E->PtNext == NULL) return plist;
+
+	for (I = 1, E = plist; I < plength / 2; I++) E = E->PtNext;	/* divisão ao meio */
+	Right = E->PtNext; E->PtNext = NULL;
+	Left = SortAdjacency (plist, plength / 2);
+	Right = SortAdjacency (Right, plength - plength / 2);
+
+	/* fusão das duas metades ordenadas */
+	for (plist = Tail = NULL; Left != NULL && Right != NULL; Tail = E)
+	{
+		if (Right->Number < Left->Number) { E = Right; Right = Right->PtNext; }
+		else { E = Left; Left = Left->PtNext; }
+		if (Tail == NULL) plist = E; else Tail->PtNext = E;
+	}
+	Tail->PtNext = Left != NULL ? Left : Right;
+	return plist;
+}
 
-/* Funo que insere, de facto, uma aresta no dgrafo/grafo. Em caso de sucesso devolve OK, seno devolve NO_MEM para assinalar falta de memria. */
+/* Função que coloca em porder os índices do instantâneo pcsr pela ordem da estratégia pstrategy: REORDER_BFS (pesquisas em largura a partir dos vértices pela ordem atual), REORDER_RCM (Cuthill-McKee inversa: pesquisas em largura a partir dos vértices de menor grau, com os vizinhos por grau crescente, e ordem final invertida) ou REORDER_DEGREE (grau decrescente). Num dígrafo, o grau é a soma dos semigraus e as pesquisas seguem os arcos emergentes. Devolve OK ou NO_MEM. */
 
-static int InsertEdge (PtBiNode pv1, PtBiNode pv2, int pcost)
+static int ReorderCSR (PtDigraphCSR pcsr, unsigned int pstrategy, unsigned int *porder)
 {
-	PtBiNode Insert, Node;	/* posio de insero e nova aresta */
+	unsigned int *Degree, *Count, *ByDegree, N = pcsr->NVertexes, MaxDegree = 0, I, A, Key, S, V, Head = 0, Tail = 0, First;
+	unsigned char *Visited; struct degreekey *Keys;
 
-					/* criar o bin e a aresta */
-	if ((Node = CreateBiNode (pv2->Number)) == NULL) return NO_MEM;
-	if ((Node->PtElem = CreateEdge (pcost)) == NULL)
-	{ free (Node); return NO_MEM; }
+	Degree = (unsigned int *) calloc (N, sizeof (unsigned int));
+	ByDegree = (unsigned int *) malloc (N * sizeof (unsigned int));
+	Visited = (unsigned char *) calloc (N, sizeof (unsigned char));
+	Keys = (struct degreekey *) malloc (N * sizeof (struct degreekey));
+	if (Degree == NULL || ByDegree == NULL || Visited == NULL || Keys == NULL)
+	{ free (Degree); free (ByDegree); free (Visited); free (Keys); return NO_MEM; }
 
-					/* determinar posio de colocao e inserir a aresta */
-	if (pv1->PtAdj == NULL || pv1->PtAdj->Number > pv2->Number)
-	{				/* insero  cabea da lista das arestas */
-		Node->PtNext = pv1->PtAdj; pv1->PtAdj = Node;
-		if (Node->PtNext != NULL) Node->PtNext->PtPrev = Node;
+	for (I = 0; I < N; I++)
+	{
+		Degree[I] += pcsr->Offset[I+1] - pcsr->Offset[I];
+		if (pcsr->Type)	/* num dígrafo, somar o semigrau incidente */
+			for (A = pcsr->Offset[I]; A < pcsr->Offset[I+1]; A++) Degree[pcsr->Target[A]]++;
 	}
-	else
-	{				/* insero  frente do n de insero */
-		Insert = InPosition (pv1->PtAdj, pv2->Number);
-		Node->PtNext = Insert->PtNext;
-		if (Node->PtNext != NULL) Node->PtNext->PtPrev = Node;
-		Node->PtPrev = Insert; Insert->PtNext = Node;
+	for (I = 0; I < N; I++) if (Degree[I] > MaxDegree) MaxDegree = Degree[I];
+
+	/* índices por grau crescente (ou decrescente), com uma ordenação por contagem estável */
+	if ((Count = (unsigned int *) calloc (MaxDegree + 2, sizeof (unsigned int))) == NULL)
+	{ free (Degree); free (ByDegree); free (Visited); free (Keys); return NO_MEM; }
+	for (I = 0; I < N; I++)
+	{
+		Key = pstrategy == REORDER_DEGREE ? MaxDegree - Degree[I] : Degree[I];
+		Count[Key+1]++;
+	}
+	for (Key = 0; Key <= MaxDegree; Key++) Count[Key+1] += Count[Key];
+	for (I = 0; I < N; I++)
+	{
+		Key = pstrategy == REORDER_DEGREE ? MaxDegree - Degree[I] : Degree[I];
+		ByDegree[Count[Key]++] = I;
 	}
+	free (Count);
+
+	if (pstrategy == REORDER_DEGREE) memcpy (porder, ByDegree, N * sizeof (unsigned int));
+	else
+		for (S = 0; S < N; S++)
+		{		/* nova pesquisa em largura a partir do vértice por visitar seguinte */
+			V = pstrategy == REORDER_RCM ? ByDegree[S] : S;
+			if (Visited[V]) continue;
+			Visited[V] = 1; porder[Tail++] = V;
+
+			while (Head < Tail)
+			{
+				V = porder[Head++]; First = Tail;
+				for (A = pcsr->Offset[V]; A < pcsr->Offset[V+1]; A++)
+					if (!Visited[pcsr->Target[A]])
+					{
+						Visited[pcsr->Target[A]] = 1;
+						porder[Tail++] = pcsr->Target[A];
+					}
+
+				if (pstrategy == REORDER_RCM && Tail - First > 1)
+				{	/* os vizinhos descobertos por grau crescente, estável pela ordem das adjacências */
+					for (I = First; I < Tail; I++)
+					{ Keys[I-First].Degree = Degree[porder[I]]; Keys[I-First].Position = I; Keys[I-First].Index = porder[I]; }
+					qsort (Keys, Tail - First, sizeof (struct degreekey), CompareKeys);
+					for (I = First; I < Tail; I++) porder[I] = Keys[I-First].Index;
+				}
+			}
+		}
 
-	Node->PtAdj = pv2;	/* ligar o vrtice 1 ao vrtice 2 */
-	/* incrementar semigraus dos vrtices emergente do 1 e incidente do 2 */
-	((PtVertex) pv1->PtElem)->OutDeg++;
-	((PtVertex) pv2->PtElem)->InDeg++;
+	if (pstrategy == REORDER_RCM)	/* inverter a ordem de Cuthill-McKee */
+		for (I = 0; I < N / 2; I++)
+		{ V = porder[I]; porder[I] = porder[N-1-I]; porder[N-1-I] = V; }
 
+	free (Degree); free (ByDegree); free (Visited); free (Keys);
 	return OK;
 }
 
-/* Funo que remove, de facto, uma aresta do dgrafo/grafo. */
+/* Função de comparação de dois vizinhos pelo grau e, no empate, pela posição de descoberta, para a ordenação RCM. */
 
-static void DeleteEdge (PtBiNode pv1, PtBiNode pv2)
+static int CompareKeys (const void *pa, const void *pb)
 {
-	PtBiNode Delete;	/* posio de remoo da aresta */
+	const struct degreekey *A = (const struct degreekey *) pa, *B = (const struct degreekey *) pb;
 
-					/* determinar posio de remoo da aresta */
-	Delete = OutPosition (pv1->PtAdj, pv2->Number);
+	if (A->Degree != B->Degree) return A->Degree < B->Degree ? -1 : 1;
+	return A->Position < B->Position ? -1 : A->Position > B->Position;
+}
 
-	if (Delete == pv1->PtAdj)	/* remoo da aresta */
-	{				/* remoo da aresta da cabea da lista das arestas */
-		if (Delete->PtNext != NULL) Delete->PtNext->PtPrev = NULL;
-		pv1->PtAdj = Delete->PtNext;
+/* Função que cria um dígrafo com os vértices e os arcos do instantâneo pcsr, em que o índice porder[K] passa a ser o vértice K+1. Os binós são reservados num só bloco, pelo que os vértices e, a seguir, as listas de adjacências ficam contíguos pela nova ordem. Devolve a referência do dígrafo criado ou NULL, no caso de inexistência de memória. */
+
+static PtDigraph RelabelCSR (PtDigraphCSR pcsr, unsigned int *porder, unsigned int pincoming)
+{
+	PtDigraph Digraph; PtBiNode Node, Tail = NULL; struct arc *Arcs;
+	unsigned int *New, N = pcsr->NVertexes, I, A;
+
+	New = (unsigned int *) malloc (N * sizeof (unsigned int));
+	Arcs = (struct arc *) malloc ((pcsr->NArcs + 1) * sizeof (struct arc));
+	if (New == NULL || Arcs == NULL || (Digraph = Create (pcsr->Type)) == NULL) { free (New); free (Arcs); return NULL; }
+	Digraph->PQueueKind = pcsr->PQueueKind;
+	Digraph->Incoming = pincoming;
+
+	/* os arcos com os novos números */
+	for (I = 0; I < N; I++) New[porder[I]] = I + 1;
+	for (I = 0; I < N; I++)
+		for (A = pcsr->Offset[I]; A < pcsr->Offset[I+1]; A++)
+		{ Arcs[A].V1 = New[I]; Arcs[A].V2 = New[pcsr->Target[A]]; Arcs[A].Cost = pcsr->Cost[A]; }
+	free (New);
+
+	if (ReserveNodes (Digraph, N + (pincoming && pcsr->Type ? 2 : 1) * pcsr->NArcs) != OK || GrowIndex (Digraph, N) != OK)
+	{ free (Arcs); Destroy (&Digraph); return NULL; }
+
+	/* os vértices 1 a N pela ordem da lista */
+	for (I = 1; I <= N; I++, Tail = Node)
+	{
+		Node = CreateBiNode (Digraph, I);
+		if (Tail == NULL) Digraph->Head = Node;
+		else { Tail->PtNext = Node; Node->PtPrev = Tail; }
+		Digraph->Index[I] = Node;
 	}
-	else
-	{				/* remoo de outra aresta do vrtice */
-		Delete->PtPrev->PtNext = Delete->PtNext;
-		if (Delete->PtNext != NULL) Delete->PtNext->PtPrev = Delete->PtPrev;
+	Digraph->NVertexes = N;
+
+	if (BulkInsertEdges (Digraph, Arcs, pcsr->NArcs) != OK) Destroy (&Digraph);
+	free (Arcs);
+	return Digraph;
+}
+
+/* Função que troca as estruturas (vértices, binós, partilhas e caches) dos dígrafos pdig1 e pdig2, mantendo em cada um o tipo, as contagens, as opções e a exclusão mútua. */
+
+static void SwapStructure (PtDigraph pdig1, PtDigraph pdig2)
+{
+	struct digraph Tmp;
+
+	Tmp.Head = pdig1->Head; pdig1->Head = pdig2->Head; pdig2->Head = Tmp.Head;
+	Tmp.Index = pdig1->Index; pdig1->Index = pdig2->Index; pdig2->Index = Tmp.Index;
+	Tmp.IndexSize = pdig1->IndexSize; pdig1->IndexSize = pdig2->IndexSize; pdig2->IndexSize = Tmp.IndexSize;
+	Tmp.Slabs = pdig1->Slabs; pdig1->Slabs = pdig2->Slabs; pdig2->Slabs = Tmp.Slabs;
+	Tmp.FreeNodes = pdig1->FreeNodes; pdig1->FreeNodes = pdig2->FreeNodes; pdig2->FreeNodes = Tmp.FreeNodes;
+	Tmp.Borrowed = pdig1->Borrowed; pdig1->Borrowed = pdig2->Borrowed; pdig2->Borrowed = Tmp.Borrowed;
+	Tmp.Share = pdig1->Share; pdig1->Share = pdig2->Share; pdig2->Share = Tmp.Share;
+	Tmp.Present = pdig1->Present; pdig1->Present = pdig2->Present; pdig2->Present = Tmp.Present;
+	Tmp.Reverse = pdig1->Reverse; pdig1->Reverse = pdig2->Reverse; pdig2->Reverse = Tmp.Reverse;
+	Tmp.Order = pdig1->Order; pdig1->Order = pdig2->Order; pdig2->Order = Tmp.Order;
+	Tmp.OrderVersion = pdig1->OrderVersion; pdig1->OrderVersion = pdig2->OrderVersion; pdig2->OrderVersion = Tmp.OrderVersion;
+	Tmp.OrderStatus = pdig1->OrderStatus; pdig1->OrderStatus = pdig2->OrderStatus; pdig2->OrderStatus = Tmp.OrderStatus;
+	Tmp.Parent = pdig1->Parent; pdig1->Parent = pdig2->Parent; pdig2->Parent = Tmp.Parent;
+	Tmp.Rank = pdig1->Rank; pdig1->Rank = pdig2->Rank; pdig2->Rank = Tmp.Rank;
+	Tmp.PartitionSize = pdig1->PartitionSize; pdig1->PartitionSize = pdig2->PartitionSize; pdig2->PartitionSize = Tmp.PartitionSize;
+	Tmp.PartitionVersion = pdig1->PartitionVersion; pdig1->PartitionVersion = pdig2->PartitionVersion; pdig2->PartitionVersion = Tmp.PartitionVersion;
+}
+
+/* Função que ordena os pnarcs arcos de um lote por (emergente, incidente), com duas passagens de contagem estáveis indexadas pelo número do vértice, pelo que os arcos de cada par ficam pela ordem das operações. Devolve OK ou NO_MEM. */
+
+static int SortBatchArcs (PtDigraph pdig, struct batcharc *parcs, unsigned int pnarcs)
+{
+	struct batcharc *Tmp; unsigned int *Count, Pass, A, N, Key;
+
+	Tmp = (struct batcharc *) malloc ((pnarcs + 1) * sizeof (struct batcharc));
+	Count = (unsigned int *) malloc ((pdig->IndexSize + 1) * sizeof (unsigned int));
+	if (Tmp == NULL || Count == NULL) { free (Tmp); free (Count); return NO_MEM; }
+
+	for (Pass = 0; Pass < 2; Pass++)	/* primeiro pelo incidente, depois pelo emergente */
+	{
+		memset (Count, 0, (pdig->IndexSize + 1) * sizeof (unsigned int));
+		for (A = 0; A < pnarcs; A++)
+		{
+			Key = Pass ? parcs[A].V1 : parcs[A].V2;
+			Count[Key+1]++;
+		}
+		for (N = 0; N < pdig->IndexSize; N++) Count[N+1] += Count[N];
+		for (A = 0; A < pnarcs; A++)
+		{
+			Key = Pass ? parcs[A].V1 : parcs[A].V2;
+			Tmp[Count[Key]++] = parcs[A];
+		}
+		memcpy (parcs, Tmp, pnarcs * sizeof (struct batcharc));
 	}
 
-	DestroyBiNode (&Delete);	/* destruir bin com aresta */
+	free (Tmp); free (Count);
+	return OK;
+}
 
-	/* decrementar semigraus dos vrtices emergente do 1 e incidente do 2 */
-	((PtVertex) pv1->PtElem)->OutDeg--;
-	((PtVertex) pv2->PtElem)->InDeg--;
+/* Pesquisa em largura, sem pesos, a partir do vértice psource, obtendo os vértices pela tabela de acesso direto pindex. Marca com a época pepoch em pmark (indexado pelo número do vértice) os vértices alcançados e coloca-os na fronteira pfrontier, que tem capacidade para todos os vértices. Devolve o número de vértices alcançados, incluindo o de partida, que fica na primeira posição da fronteira. */
+
+static unsigned int ReachSearch (PtBiNode *pindex, PtBiNode psource, unsigned int *pmark, unsigned int pepoch, PtBiNode *pfrontier)
+{
+	PtBiNode E; unsigned int Front = 0, Rear = 0;
+
+	pmark[psource->Number] = pepoch; pfrontier[Rear++] = psource;
+	while (Front < Rear)
+		for (E = pfrontier[Front++]->PtAdj; E != NULL; E = E->PtNext)
+			if (pmark[E->Number] != pepoch)
+			{	/* marcar e colocar na fronteira os vértices ainda não alcançados */
+				pmark[E->Number] = pepoch;
+				pfrontier[Rear++] = pindex[E->Number];
+			}
+	return Rear;	/* cada vértice entra na fronteira uma única vez */
 }
 
-/* Funo que cria o vrtice do dgrafo/grafo. Devolve a referncia do vrtice criado ou NULL, caso no consiga cri-lo por falta de memria. */
- 
-static PtVertex CreateVertex (void)
+/* Função que cria um instantâneo CSR com capacidade para pnv vértices, pna arcos e números de vértice até pmax. Devolve a referência do instantâneo criado ou NULL, caso não consiga criá-lo por falta de memória. */
+
+static PtDigraphCSR CreateCSR (unsigned int pnv, unsigned int pna, unsigned int pmax)
 {
-	PtVertex Vertex;
+	PtDigraphCSR CSR; unsigned int I;
+
+	if ((CSR = (PtDigraphCSR) malloc (sizeof (struct csr))) == NULL) return NULL;
+
+	CSR->NVertexes = pnv; CSR->NArcs = pna; CSR->NEdges = 0;
+	CSR->Type = 1; CSR->MaxNumber = pmax; CSR->PQueueKind = PQUEUE_BINARY;
+	CSR->Mapping = NULL; CSR->MappingSize = 0;
+	CSR->ROffset = CSR->RSource = NULL;
+	CSR->Number = (unsigned int *) malloc ((pnv + 1) * sizeof (unsigned int));
+	CSR->Map = (unsigned int *) malloc ((pmax + 1) * sizeof (unsigned int));
+	CSR->Offset = (unsigned int *) malloc ((pnv + 1) * sizeof (unsigned int));
+	CSR->Target = (unsigned int *) malloc ((pna + 1) * sizeof (unsigned int));
+	CSR->Cost = (int *) malloc ((pna + 1) * sizeof (int));
+
+	if (CSR->Number == NULL || CSR->Map == NULL || CSR->Offset == NULL || CSR->Target == NULL || CSR->Cost == NULL)
+	{ CSRDestroy (&CSR); return NULL; }
+
+	for (I = 0; I <= pmax; I++) CSR->Map[I] = NO_INDEX;	/* números sem vértice */
+	CSR->Offset[0] = 0;
+	return CSR;	/* devolve o instantâneo criado */
+}
 
-	if ((Vertex = (PtVertex) malloc (sizeof (struct vertex))) == NULL)
-		return NULL;
+/* Pesquisa em largura sobre sequências CSR a partir do índice psource, marcando em pvisit os índices alcançados. A fila pqueue tem capacidade para todos os índices. Devolve o número de índices marcados, incluindo o de partida. */
+
+static unsigned int CSRSearch (unsigned int psource, unsigned int *poffset, unsigned int *ptarget, unsigned char *pvisit, unsigned int *pqueue)
+{
+	unsigned int Front = 0, Rear = 0, Index, Arc;
 
-	Vertex->InDeg = 0;	/* inicializa o semigrau incidente */
-	Vertex->OutDeg = 0;	/* inicializa o semigrau emergente */
-	return Vertex;	/* devolve o vrtice criado */
+	pvisit[psource] = 1; pqueue[Rear++] = psource;
+	while (Front < Rear)
+	{
+		Index = pqueue[Front++];	/* retirar o índice da frente da fila */
+		for (Arc = poffset[Index]; Arc < poffset[Index+1]; Arc++)
+			if (!pvisit[ptarget[Arc]])
+			{	/* marcar e colocar na fila os índices ainda não alcançados */
+				pvisit[ptarget[Arc]] = 1;
+				pqueue[Rear++] = ptarget[Arc];
+			}
+	}
+	return Rear;	/* cada índice entra na fila uma única vez */
 }
 
-/* Funo que cria a aresta do dgrafo/grafo. Devolve a referncia da aresta criada ou NULL, caso no consiga cri-la por falta de memria. */
+/* Função que verifica se as sequências do instantâneo pcsr projetado de um ficheiro são coerentes, em tempo linear na dimensão do ficheiro: Offset não decresce e termina em NArcs, todos os arcos incidem num índice válido e Number e Map são inversas uma da outra dentro de 1 a MaxNumber. Não converte nada, só garante que nenhuma consulta lê fora das sequências. Devolve 1 se o instantâneo é válido e 0 caso contrário. */
 
-static PtEdge CreateEdge (int pcost)
+static int CSRValid (PtDigraphCSR pcsr)
 {
-	PtEdge Edge;
+	unsigned int Index, Arc, Number;
 
-	if ((Edge = (PtEdge) malloc (sizeof (struct edge))) == NULL)
-		return NULL;
+	if (pcsr->MaxNumber == UINT_MAX || pcsr->Offset[0] != 0 || pcsr->Offset[pcsr->NVertexes] != pcsr->NArcs) return 0;
+	for (Index = 0; Index < pcsr->NVertexes; Index++)
+	{
+		if (pcsr->Offset[Index+1] < pcsr->Offset[Index]) return 0;
+		Number = pcsr->Number[Index];
+		if (Number == 0 || Number > pcsr->MaxNumber || pcsr->Map[Number] != Index) return 0;
+	}
+	for (Arc = 0; Arc < pcsr->NArcs; Arc++)
+		if (pcsr->Target[Arc] >= pcsr->NVertexes) return 0;
+					/* números sem vértice não podem apontar para um índice */
+	for (Number = 0; Number <= pcsr->MaxNumber; Number++)
+		if (pcsr->Map[Number] != NO_INDEX && (pcsr->Map[Number] >= pcsr->NVertexes || pcsr->Number[pcsr->Map[Number]] != Number)) return 0;
+	return 1;
+}
+
+/* Função que constrói, uma única vez, as adjacências inversas do instantâneo pcsr (dígrafo transposto), que ficam guardadas no instantâneo até CSRDestroy; como o instantâneo é imutável, nunca ficam desatualizadas. Devolve OK ou NO_MEM. */
 
-	Edge->Cost = pcost;	/* armazena o custo da aresta */
-	return Edge;	/* devolve a aresta criada */
+static int CSRReverse (PtDigraphCSR pcsr)
+{
+	unsigned int *ROffset, *RSource, Index, Arc;
+
+	pthread_mutex_lock (&ReverseLock);
+	if (pcsr->ROffset != NULL) { pthread_mutex_unlock (&ReverseLock); return OK; }
+
+	ROffset = (unsigned int *) calloc (pcsr->NVertexes + 1, sizeof (unsigned int));
+	RSource = (unsigned int *) malloc ((pcsr->NArcs + 1) * sizeof (unsigned int));
+	if (ROffset == NULL || RSource == NULL)
+	{ free (ROffset); free (RSource); pthread_mutex_unlock (&ReverseLock); return NO_MEM; }
+
+	for (Arc = 0; Arc < pcsr->NArcs; Arc++) ROffset[pcsr->Target[Arc]+1]++;
+	for (Index = 0; Index < pcsr->NVertexes; Index++) ROffset[Index+1] += ROffset[Index];
+	for (Index = 0; Index < pcsr->NVertexes; Index++)
+		for (Arc = pcsr->Offset[Index]; Arc < pcsr->Offset[Index+1]; Arc++)
+			RSource[ROffset[pcsr->Target[Arc]]++] = Index;
+	for (Index = pcsr->NVertexes; Index > 0; Index--) ROffset[Index] = ROffset[Index-1];
+	ROffset[0] = 0;
+
+	pcsr->ROffset = ROffset; pcsr->RSource = RSource;
+	pthread_mutex_unlock (&ReverseLock);
+	return OK;
 }
 
-/* Funo que cria o bin da lista de vrtices ou da lista de arestas. Devolve a referncia do bin criado ou NULL, caso no consiga cri-lo por falta de memria. */
+/* Função executada por cada fio de CSRBreadthFirst, incluindo o que a chama. Inicializa a sua parte das sequências de saída e depois, nível a nível, expande a fronteira no sentido escolhido, com as palavras dos conjuntos de bits distribuídas dinamicamente entre os fios; entre dois níveis, o primeiro fio troca as fronteiras e escolhe o sentido do nível seguinte, enquanto os outros esperam na barreira. */
 
-static PtBiNode CreateBiNode (unsigned int pnumber)
+static void *BreadthWorker (void *ppart)
 {
-	PtBiNode Node;
+	struct breadthpart *Part = (struct breadthpart *) ppart; struct breadthjob *Job = Part->Job;
+	PtDigraphCSR CSR = Job->CSR; unsigned int Word, Last, Index, End;
 
-	if ((Node = (PtBiNode) malloc (sizeof (struct binode))) == NULL)
-		return NULL;
+	while ((Word = __atomic_fetch_add (&Job->Cursor, BFS_CHUNK, __ATOMIC_RELAXED)) < Job->Words)
+	{
+		Last = Word + BFS_CHUNK < Job->Words ? Word + BFS_CHUNK : Job->Words;
+		End = Last == Job->Words ? CSR->NVertexes : Last * WORD_BITS;
+		for (Index = Word * WORD_BITS; Index < End; Index++)
+		{
+			Job->Pred[CSR->Number[Index]-1] = 0;
+			Job->Cost[CSR->Number[Index]-1] = INT_MAX;
+		}
+	}
+	BreadthBarrier (Job);
 
-	Node->PtNext = NULL;	/* bin aponta para a frente para NULL */
-	Node->PtPrev = NULL;	/* bin aponta para a trs para NULL */
-	Node->PtAdj = NULL;	/* lista de adjacncias nula */
-	Node->Number = pnumber;	/* armazena o identificador do bin */
-	return Node;	/* devolve o bin criado */
+	while (1)
+	{
+		if (Part == Job->Parts) BreadthSwitch (Job);
+		BreadthBarrier (Job);
+		if (Job->Done) break;
+
+		Part->Count = Part->Arcs = 0;
+		if (Job->BottomUp) BreadthBottomUp (Part);
+		else BreadthTopDown (Part);
+		BreadthBarrier (Job);
+	}
+	return NULL;
 }
 
-/* Funo que liberta a memria ocupada pelo bin e pelo seu elemento. */
+/* Nível descendente: cada índice da fronteira percorre os seus arcos emergentes e reclama os índices ainda não alcançados, marcando-os atomicamente em Visit, de modo que cada índice tem um só predecessor mesmo quando vários fios o encontram ao mesmo tempo. */
 
-static void DestroyBiNode (PtBiNode *pbinode)
+static void BreadthTopDown (struct breadthpart *ppart)
 {
-	if (*pbinode == NULL) return;
+	struct breadthjob *Job = ppart->Job; PtDigraphCSR CSR = Job->CSR;
+	unsigned int Word, Last, Index, Arc, Target; BITWORD Bits, Bit;
+
+	while ((Word = __atomic_fetch_add (&Job->Cursor, BFS_CHUNK, __ATOMIC_RELAXED)) < Job->Words)
+		for (Last = Word + BFS_CHUNK < Job->Words ? Word + BFS_CHUNK : Job->Words; Word < Last; Word++)
+			for (Bits = Job->Frontier[Word]; Bits != 0; Bits &= Bits - 1)
+			{
+				Index = Word * WORD_BITS + __builtin_ctzl (Bits);
+				for (Arc = CSR->Offset[Index]; Arc < CSR->Offset[Index+1]; Arc++)
+				{
+					Target = CSR->Target[Arc]; Bit = 1UL << (Target % WORD_BITS);
+								/* leitura prévia para evitar a operação atómica */
+					if (__atomic_load_n (&Job->Visit[Target / WORD_BITS], __ATOMIC_RELAXED) & Bit) continue;
+					if (__atomic_fetch_or (&Job->Visit[Target / WORD_BITS], Bit, __ATOMIC_RELAXED) & Bit) continue;
+
+					__atomic_fetch_or (&Job->Next[Target / WORD_BITS], Bit, __ATOMIC_RELAXED);
+					Job->Pred[CSR->Number[Target]-1] = CSR->Number[Index];
+					Job->Cost[CSR->Number[Target]-1] = (int) Job->Level;
+					ppart->Count++; ppart->Arcs += CSR->Offset[Target+1] - CSR->Offset[Target];
+				}
+			}
+}
 
-	free ((*pbinode)->PtElem);
-	free (*pbinode);
-	*pbinode = NULL;
+/* Nível ascendente: cada índice ainda não alcançado procura nos seus arcos incidentes um predecessor na fronteira e pára no primeiro. Cada palavra de Visit e de Next pertence ao fio que a recebeu, pelo que não há operações atómicas. */
+
+static void BreadthBottomUp (struct breadthpart *ppart)
+{
+	struct breadthjob *Job = ppart->Job; PtDigraphCSR CSR = Job->CSR;
+	unsigned int Word, Last, Index, Arc, Source; BITWORD Bits, Found;
+
+	while ((Word = __atomic_fetch_add (&Job->Cursor, BFS_CHUNK, __ATOMIC_RELAXED)) < Job->Words)
+		for (Last = Word + BFS_CHUNK < Job->Words ? Word + BFS_CHUNK : Job->Words; Word < Last; Word++)
+		{
+			for (Found = 0, Bits = ~Job->Visit[Word]; Bits != 0; Bits &= Bits - 1)
+			{
+				if ((Index = Word * WORD_BITS + __builtin_ctzl (Bits)) >= CSR->NVertexes) break;
+				for (Arc = Job->ROffset[Index]; Arc < Job->ROffset[Index+1]; Arc++)
+				{
+					Source = Job->RSource[Arc];
+					if (!BIT_TEST (Job->Frontier, Source)) continue;
+
+					Found |= 1UL << (Index % WORD_BITS);
+					Job->Pred[CSR->Number[Index]-1] = CSR->Number[Source];
+					Job->Cost[CSR->Number[Index]-1] = (int) Job->Level;
+					ppart->Count++; ppart->Arcs += CSR->Offset[Index+1] - CSR->Offset[Index];
+					break;
+				}
+			}
+			Job->Visit[Word] |= Found; Job->Next[Word] = Found;
+		}
 }
 
-/* Funo de pesquisa para insero. Devolve um ponteiro para o bin  frente do qual deve ser feita a insero do novo vrtice (nova aresta) ou NULL, caso o vrtice (a aresta) j exista. */
- 
-static PtBiNode InPosition (PtBiNode phead, unsigned int pnumber)
+/* Passagem ao nível seguinte, feita pelo primeiro fio entre duas barreiras: soma as contagens dos fios, troca as fronteiras e escolhe o sentido do nível com a heurística de Beamer. Passa a ascendente quando os arcos da nova fronteira excedem os arcos por explorar a dividir por BFS_ALPHA, e regressa a descendente quando a fronteira, a diminuir, fica abaixo dos vértices a dividir por BFS_BETA. Sem memória para as adjacências inversas de um dígrafo, continua descendente. */
+
+static void BreadthSwitch (struct breadthjob *pjob)
 {
-	PtBiNode Node, Prev;
+	PtDigraphCSR CSR = pjob->CSR; BITWORD *Swap; unsigned int Count = 0, Arcs = 0, J;
 
-	for (Node = phead; Node != NULL; Node = Node->PtNext)
+	for (J = 0; J < pjob->NParts; J++) { Count += pjob->Parts[J].Count; Arcs += pjob->Parts[J].Arcs; }
+	Swap = pjob->Frontier; pjob->Frontier = pjob->Next; pjob->Next = Swap;
+	if (Count == 0) { pjob->Done = 1; return; }
+	pjob->Unexplored -= Arcs;
+
+	if (!pjob->BottomUp && Arcs > pjob->Unexplored / BFS_ALPHA)
 	{
-		if (Node->Number >= pnumber) break;
-		Prev = Node;
+		if (!CSR->Type) { pjob->ROffset = CSR->Offset; pjob->RSource = CSR->Target; }	/* grafo: simétrico */
+		else if (pjob->ROffset == NULL && CSRReverse (CSR) == OK)
+		{ pjob->ROffset = CSR->ROffset; pjob->RSource = CSR->RSource; }
+		pjob->BottomUp = pjob->ROffset != NULL;
 	}
+	else if (pjob->BottomUp && Count < pjob->Count && Count < CSR->NVertexes / BFS_BETA) pjob->BottomUp = 0;
 
-	if (Node == NULL || Node->Number > pnumber) return Prev;
-	else return NULL;	/* o elemento j existe */
+	if (!pjob->BottomUp) memset (pjob->Next, 0, pjob->Words * sizeof (BITWORD));	/* o nível ascendente escreve todas as palavras */
+	pjob->Count = Count; pjob->Level++; pjob->Cursor = 0;
 }
 
-/* Funo de pesquisa para remoo. Devolve um ponteiro para o bin onde se encontra o vrtice (a aresta) ou NULL, caso o vrtice (a aresta) no exista. */
+/* Barreira dos fios de CSRBreadthFirst: o último fio a chegar abre a ronda. Enquanto o número de fios não é conhecido (0), nenhum fio a pode abrir. */
 
-static PtBiNode OutPosition (PtBiNode phead, unsigned int pnumber)
+static void BreadthBarrier (struct breadthjob *pjob)
 {
-	PtBiNode Node;
+	unsigned int Round;
+
+	pthread_mutex_lock (&pjob->Lock);
+	Round = pjob->Round;
+	if (++pjob->Waiting == pjob->Threads)
+	{ pjob->Waiting = 0; pjob->Round++; pthread_cond_broadcast (&pjob->Wake); }
+	else while (Round == pjob->Round) pthread_cond_wait (&pjob->Wake, &pjob->Lock);
+	pthread_mutex_unlock (&pjob->Lock);
+}
 
-	for (Node = phead; Node != NULL; Node = Node->PtNext)
-		if (Node->Number == pnumber) break;
-	return Node;
+/* Função que devolve o índice inverso dos arcos incidentes do dígrafo pdig, construindo-o de novo se o dígrafo mudou desde a última construção. A construção é protegida por um mutex, para que vários fios possam consultar em simultâneo o mesmo dígrafo. Devolve NULL por falta de memória. */
+
+static struct reverse *ReverseIndex (PtDigraph pdig)
+{
+	struct reverse *Rev; PtBiNode V, E; unsigned int N, A;
+
+	pthread_mutex_lock (&pdig->CacheLock);
+	if ((Rev = pdig->Reverse) != NULL && Rev->Version == pdig->Version)
+	{
+		pthread_mutex_unlock (&pdig->CacheLock); return Rev;
+	}
+
+	FreeReverse (Rev); pdig->Reverse = NULL;
+	if ((Rev = (struct reverse *) malloc (sizeof (struct reverse))) != NULL)
+	{
+		Rev->Version = pdig->Version; Rev->Size = pdig->IndexSize;
+		Rev->Offset = (unsigned int *) calloc (Rev->Size + 1, sizeof (unsigned int));
+		Rev->Source = (unsigned int *) malloc ((pdig->NEdges + 1) * sizeof (unsigned int));
+		Rev->Cost = (int *) malloc ((pdig->NEdges + 1) * sizeof (int));
+		if (Rev->Offset == NULL || Rev->Source == NULL || Rev->Cost == NULL) { FreeReverse (Rev); Rev = NULL; }
+	}
+
+	if (Rev != NULL)
+	{		/* contagem dos arcos incidentes e somas prefixas */
+		for (V = pdig->Head; V != NULL; V = V->PtNext) Rev->Offset[V->Number+1] = V->Elem.Vertex.InDeg;
+		for (N = 1; N <= Rev->Size; N++) Rev->Offset[N] += Rev->Offset[N-1];
+				/* distribuição dos arcos, usando Offset como cursor */
+		for (V = pdig->Head; V != NULL; V = V->PtNext)
+			for (E = V->PtAdj; E != NULL; E = E->PtNext)
+			{
+				A = Rev->Offset[E->Number]++;
+				Rev->Source[A] = V->Number; Rev->Cost[A] = E->Elem.Edge.Cost;
+			}
+				/* repor o início de cada vértice */
+		for (N = Rev->Size; N > 0; N--) Rev->Offset[N] = Rev->Offset[N-1];
+		Rev->Offset[0] = 0;
+		pdig->Reverse = Rev;
+	}
+
+	pthread_mutex_unlock (&pdig->CacheLock);
+	return Rev;
 }
 
-/* Algoritmo de Dijkstra que determina os caminhos mais curtos de todos os vrtices alcancveis pelo vrtice pvertice. Esta verso assume que o digrafo, o vrtice de partida e as sequncias foram previamente validados. */
+/* Função que liberta o índice inverso prev. */
 
-static int DijkstraPQueue (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pcost[])
+static void FreeReverse (struct reverse *prev)
 {
-	PtPQueue PQueue; PtBiNode V, E; int Cost; VERTEX Elem;
+	if (prev == NULL) return;
 
-	if (pdig == NULL) return NO_DIGRAPH;
-	if (pdig->NVertexes == 0) return DIGRAPH_EMPTY;
-				/* verificar se o vrtice de partida existe */
-	if ((V = OutPosition (pdig->Head, pv)) == NULL) return NO_VERTEX;
+	free (prev->Offset); free (prev->Source); free (prev->Cost);
+	free (prev);
+}
 
-	PQueue = PQueueCreate (pdig->NVertexes);	/* criar a fila com prioridade */
-	for (V = pdig->Head; V != NULL; V = V->PtNext)
+/* Pesquisa de Dijkstra bidirecional de psource para ptarget, no contexto pquery preparado com dois sentidos: Side[0] avança pelos arcos emergentes a partir de psource e Side[1] pelos arcos incidentes (listas de arcos incidentes ou índice inverso) a partir de ptarget, guardando em Pred o vértice seguinte no caminho. Expande-se sempre o sentido com a menor chave retirada e termina quando a soma das duas chaves não pode melhorar o melhor caminho encontrado. Coloca em pbest o custo do caminho (INT_MAX se não existe) e em pmeet o vértice de encontro. Devolve OK ou NO_MEM. */
+
+static int BidirectionalSearch (PtDigraph pdig, PtBiNode psource, PtBiNode ptarget, PtQuery pquery, unsigned int *pmeet, int *pbest)
+{
+	struct reverse *Rev = NULL; struct search *Side, *Other; PtBiNode E; VERTEX Elem;
+	unsigned int Epoch = pquery->Epoch, S, A; int Last[2];
+
+		/* num grafo, as listas servem nos dois sentidos; num dígrafo, usam-se as listas de arcos incidentes ou o índice inverso */
+	if (pdig->Type && !pdig->Incoming && (Rev = ReverseIndex (pdig)) == NULL) return NO_MEM;
+
+	for (S = 0; S < 2; S++)
+	{		/* cada sentido começa no seu extremo */
+		Side = &pquery->Side[S];
+		Elem.Vertex = S == 0 ? psource->Number : ptarget->Number; Elem.Cost = 0;
+		Side->Mark[Elem.Vertex] = Epoch; Side->Pred[Elem.Vertex] = 0; Side->Cost[Elem.Vertex] = 0;
+		PQueueInsert (Side->PQueue, &Elem);
+		Last[S] = 0;
+	}
+	if (psource == ptarget) { *pbest = 0; *pmeet = psource->Number; return OK; }
+
+	while (!PQueueIsEmpty (pquery->Side[0].PQueue) && !PQueueIsEmpty (pquery->Side[1].PQueue))
 	{
-		V->Visit = 0;	/* desmarcar o vrtice */
-		pvpred[V->Number-1] = 0;	/* inicializar o predecessor */
-		pcost[V->Number-1] = INT_MAX;	/* inicializar o custo */
+		if (*pbest != INT_MAX && Last[0] + Last[1] >= *pbest) break;	/* as fronteiras já se cruzaram */
+
+		S = Last[0] <= Last[1] ? 0 : 1;
+		Side = &pquery->Side[S]; Other = &pquery->Side[1-S];
+		PQueueDeleteMin (Side->PQueue, &Elem);
+		Last[S] = Elem.Cost;
+		Side->Mark[Elem.Vertex] = Epoch + 1;	/* marcar o vértice como conhecido */
+
+		if (S == 0 || !pdig->Type)
+			for (E = pdig->Index[Elem.Vertex]->PtAdj; E != NULL; E = E->PtNext)
+				BidirectionalRelax (Side, Other, Elem.Vertex, E->Number, E->Elem.Edge.Cost, Epoch, pmeet, pbest);
+		else if (Rev == NULL)
+			for (E = pdig->Index[Elem.Vertex]->Elem.Vertex.PtIn; E != NULL; E = E->PtNext)
+				BidirectionalRelax (Side, Other, Elem.Vertex, E->Number, E->Elem.Edge.Cost, Epoch, pmeet, pbest);
+		else
+			for (A = Rev->Offset[Elem.Vertex]; A < Rev->Offset[Elem.Vertex+1]; A++)
+				BidirectionalRelax (Side, Other, Elem.Vertex, Rev->Source[A], Rev->Cost[A], Epoch, pmeet, pbest);
+	}
+
+	return OK;
+}
+
+/* Relaxação do arco entre pv e pw, de custo pcost, no sentido pside da pesquisa bidirecional. Se pw já foi alcançado pelo sentido pother, o caminho que passa por pw é candidato ao melhor caminho (pbest, pmeet). */
+
+static void BidirectionalRelax (struct search *pside, struct search *pother, unsigned int pv, unsigned int pw, int pcost, unsigned int pepoch, unsigned int *pmeet, int *pbest)
+{
+	int Cost; VERTEX Elem;
 
-				/* construir o elemento e p-lo na fila com prioridade */
-		Elem.Vertex = V->Number; Elem.Cost = pcost[V->Number-1];
-		PQueueInsert (PQueue, &Elem);
+	if (pside->Mark[pw] == pepoch + 1) return;	/* não processar vértices conhecidos */
+
+	Cost = pside->Cost[pv] + pcost;
+	if (pside->Mark[pw] != pepoch || Cost < pside->Cost[pw])
+	{		/* atualizar o percurso e o custo desta travessia */
+		pside->Mark[pw] = pepoch; pside->Pred[pw] = pv; pside->Cost[pw] = Cost;
+		Elem.Vertex = pw; Elem.Cost = Cost;
+		if (PQueueContains (pside->PQueue, pw) == OK) PQueueDecrease (pside->PQueue, &Elem);
+		else PQueueInsert (pside->PQueue, &Elem);
 	}
-				/* inicializar o vrtice de partida e atualiz-lo na fila */
-	Elem.Vertex = pv; Elem.Cost = pcost[pv-1] = 0;
-	PQueueDecrease (PQueue, &Elem);
 
-	while (!PQueueIsEmpty (PQueue))
-	{		/* retirar o elemento da fila e pesquisar o vrtice no grafo */
-		PQueueDeleteMin (PQueue, &Elem);
-		V = OutPosition (pdig->Head, Elem.Vertex);
-		V->Visit = 1;	/* marcar o vrtice como conhecido */
-		if (pcost[V->Number-1] == INT_MAX) continue;
+	if (pother->Mark[pw] >= pepoch && pside->Cost[pw] + pother->Cost[pw] < *pbest)
+	{		/* novo melhor caminho através de pw */
+		*pbest = pside->Cost[pw] + pother->Cost[pw]; *pmeet = pw;
+	}
+}
+
+/* Pesquisa A* de psource para ptarget, no contexto pquery preparado com um sentido, ordenando a fila pelo custo mais a estimativa pheuristic até ptarget. Como a estimativa só tem de ser admissível, um vértice conhecido volta à fila se for alcançado por um caminho mais barato, pelo que a fila é sempre o amontoado binário. Termina quando ptarget sai da fila. Devolve o custo do caminho ou INT_MAX se não existe. */
+
+static int AStarSearch (PtDigraph pdig, PtBiNode psource, PtBiNode ptarget, PtHeuristic pheuristic, void *pdata, PtQuery pquery)
+{
+	struct search *Side = &pquery->Side[0]; PtBiNode V, E; VERTEX Elem;
+	unsigned int Epoch = pquery->Epoch; int Cost;
+
+	Side->Mark[psource->Number] = Epoch; Side->Pred[psource->Number] = 0; Side->Cost[psource->Number] = 0;
+	Elem.Vertex = psource->Number; Elem.Cost = pheuristic (psource->Number, ptarget->Number, pdata);
+	PQueueInsert (Side->PQueue, &Elem);
+
+	while (!PQueueIsEmpty (Side->PQueue))
+	{
+		PQueueDeleteMin (Side->PQueue, &Elem);
+		if (Elem.Vertex == ptarget->Number) return Side->Cost[Elem.Vertex];
+
+		V = pdig->Index[Elem.Vertex];
+		Side->Mark[V->Number] = Epoch + 1;	/* marcar o vértice como conhecido */
 
 		for (E = V->PtAdj; E != NULL; E = E->PtNext)
-			if (!E->PtAdj->Visit)	/* no processar vrtices conhecidos */
-			{	/* calcular o custo desta travessia */
-				Cost = pcost[V->Number-1] + ((PtEdge) E->PtElem)->Cost;
-				if (Cost < pcost[E->Number-1])
-				{	/* atualizar o percurso e o custo desta travessia */	
-					pvpred[E->Number-1] = V->Number;
-					pcost[E->Number-1] = Cost;
-				/* atualizar o elemento na fila com prioridade */
-					Elem.Vertex = E->Number; Elem.Cost = Cost;
-					PQueueDecrease (PQueue, &Elem);
-				}
+		{
+			Cost = Side->Cost[V->Number] + E->Elem.Edge.Cost;
+			if (Side->Mark[E->Number] < Epoch || Cost < Side->Cost[E->Number])
+			{	/* vértice novo ou caminho mais barato, mesmo que já conhecido */
+				Side->Mark[E->Number] = Epoch;
+				Side->Pred[E->Number] = V->Number; Side->Cost[E->Number] = Cost;
+				Elem.Vertex = E->Number; Elem.Cost = Cost + pheuristic (E->Number, ptarget->Number, pdata);
+				if (PQueueContains (Side->PQueue, E->Number) == OK) PQueueDecrease (Side->PQueue, &Elem);
+				else PQueueInsert (Side->PQueue, &Elem);
 			}
+		}
 	}
 
-	PQueueDestroy (&PQueue);	/* destruir a fila com prioridade */
-	return OK;
+	return INT_MAX;
 }
-
@@ -1,12 +1,12 @@
 /*******************************************************************************
 
- Ficheiro de interface do Tipo de Dados Abstrato Dgrafo/Grafo (digraph.h). A 
- implementao tem capacidade de mltipla instanciao, sendo providenciado um 
- construtor para criar um grafo (0) /dgrafo (1) vazio.  da responsabilidade da
- aplicao, invocar o destructor, para libertar a memria atribuda ao objecto. 
- O mdulo providencia um controlo de erro no retorno das operaes. 
+ Ficheiro de interface do Tipo de Dados Abstrato Dígrafo/Grafo (digraph.h). A 
+ implementação tem capacidade de múltipla instanciação, sendo providenciado um 
+ construtor para criar um grafo (0) /dígrafo (1) vazio. É da responsabilidade da
+ aplicação, invocar o destructor, para libertar a memória atribuída ao objecto. 
+ O módulo providencia um controlo de erro no retorno das operações. 
 
- Autor : Antnio Manuel Adrego da Rocha    Data : Maio de 2015
+ Autor : António Manuel Adrego da Rocha    Data : Maio de 2015
 
  Interface file of the abstract data type Digraph/Graph (digraph.h). The 
  implementation provides a constructor for creating an empty graph (0) /digraph (1).
@@ -19,37 +19,88 @@
 #ifndef _DIGRAPH_DYNAMIC
 #define _DIGRAPH_DYNAMIC
 
-/*********** Definio do Tipo Ponteiro para um Dgrafo/Grafo **********/
+#include <stdio.h>
+
+/*********** Definição do Tipo Ponteiro para um Dígrafo/Grafo **********/
 
 typedef struct digraph *PtDigraph;
 
-/********************* Definio de Cdigos de Erro ********************/
+/****** Definição do Tipo Ponteiro para um Instantâneo CSR Imutável ******/
+
+typedef struct csr *PtDigraphCSR;
+
+/******* Definição do Tipo Ponteiro para um Contexto de Consulta ********/
+
+typedef struct query *PtQuery;
+
+/*** Definição do Tipo Ponteiro para uma Estimativa de Custo (Heurística) ***/
+
+typedef int (*PtHeuristic) (unsigned int pv, unsigned int pdst, void *pdata);
+
+/************* Definição de uma Operação de Alteração em Lote *************/
+
+typedef struct edgeop
+{
+	unsigned int Op;	/* EDGE_INSERT ou EDGE_DELETE - operation */
+	unsigned int V1;	/* vértice emergente - source vertex */
+	unsigned int V2;	/* vértice incidente - target vertex */
+	int Cost;	/* custo da aresta inserida - cost of the inserted edge */
+	int Status;	/* código de erro da operação - error code of the operation */
+} EDGEOP;
+
+#define	EDGE_INSERT		0	/* inserir a aresta (InEdge) - insert the edge */
+#define	EDGE_DELETE		1	/* retirar a aresta (OutEdge) - delete the edge */
 
-#define	OK				0	/* operao realizada com sucesso - operation with success */
-#define	NO_DIGRAPH		1	/* dgrafo/grafo inexistente - digraph/graph does not exist*/
-#define	NO_MEM			2	/* memria esgotada - out of memory */
+/*************** Definição de um Cursor de Vértices ou de Arestas ***************/
+
+typedef struct digraphcursor
+{
+	void *Node;	/* próximo binó a visitar (opaco) - next node to visit (opaque) */
+} DIGRAPHCURSOR;
+
+/********************* Definição de Códigos de Erro ********************/
+
+#define	OK				0	/* operação realizada com sucesso - operation with success */
+#define	NO_DIGRAPH		1	/* dígrafo/grafo inexistente - digraph/graph does not exist*/
+#define	NO_MEM			2	/* memória esgotada - out of memory */
 #define	NULL_PTR		3	/* ponteiro nulo - null pointer */
-#define	DIGRAPH_EMPTY	4	/* dgrafo/grafo vazio - empty digraph/graph */
-#define	NO_VERTEX		5	/* vrtice inexistente - vertex does not exist */
-#define	REP_VERTEX		6	/* vrtice repetido - vertex already exists */
+#define	DIGRAPH_EMPTY	4	/* dígrafo/grafo vazio - empty digraph/graph */
+#define	NO_VERTEX		5	/* vértice inexistente - vertex does not exist */
+#define	REP_VERTEX		6	/* vértice repetido - vertex already exists */
 #define	NO_EDGE			7	/* aresta inexistente - edge does not exist */
 #define	REP_EDGE		8	/* aresta repetida - edge already exists */
 #define	NO_FILE			9	/* ficheiro inexistente - file does not exist */
-#define	NO_DAG			10	/* dgrafo cclico - acyclic digraph */
-#define	NEG_CYCLE		11	/* dgrafo/grafo com ciclo negativo - digraph/graph with negative loop */
-#define	NO_CONNECTED	12	/* grafo no conexo - not connected graph */
-#define	NO_PATH			13	/* no existe caminho/circuito - path/cycle does not exist */
-#define	SINK			14	/* vrtice sumidouro - sink vertex */
-#define	SOURCE			15	/* vrtice fonte - source vertex */
-#define	DISC			16	/* vrtice desconexo - disconnected vertex */
+#define	NO_DAG			10	/* dígrafo cíclico - acyclic digraph */
+#define	NEG_CYCLE		11	/* dígrafo/grafo com ciclo negativo - digraph/graph with negative loop */
+#define	NO_CONNECTED	12	/* grafo não conexo - not connected graph */
+#define	NO_PATH			13	/* não existe caminho/circuito - path/cycle does not exist */
+#define	SINK			14	/* vértice sumidouro - sink vertex */
+#define	SOURCE			15	/* vértice fonte - source vertex */
+#define	DISC			16	/* vértice desconexo - disconnected vertex */
+
+/********** Definição das Filas com Prioridade do Algoritmo de Dijkstra **********/
+
+#define	DIJKSTRA_BINARY	0	/* amontoado binário - binary heap */
+#define	DIJKSTRA_RADIX	1	/* amontoado radix monótono - monotone radix heap */
+
+/************ Definição dos Algoritmos da Árvore Geradora Mínima ************/
+
+#define	MST_PRIM		0	/* algoritmo de Prim - Prim's algorithm */
+#define	MST_KRUSKAL		1	/* algoritmo de Kruskal - Kruskal's algorithm */
+
+/************** Definição das Estratégias de Reordenação dos Vértices **************/
+
+#define	REORDER_BFS		0	/* ordem de pesquisa em largura - breadth-first search order */
+#define	REORDER_RCM		1	/* Cuthill-McKee inversa - reverse Cuthill-McKee */
+#define	REORDER_DEGREE	2	/* grau decrescente - decreasing degree */
 
-/********************* Prottipos dos Subprogramas *********************/
+/********************* Protótipos dos Subprogramas *********************/
 
 PtDigraph Create (unsigned int ptype);
 /*******************************************************************************
- Cria um dgrafo ou um grafo, caso ptype seja igual a, respetivamente, 1 ou 0.
- Devolve a referncia do dgrafo/grafo criado ou NULL, no caso de inexistncia de
- memria.
+ Cria um dígrafo ou um grafo, caso ptype seja igual a, respetivamente, 1 ou 0.
+ Devolve a referência do dígrafo/grafo criado ou NULL, no caso de inexistência de
+ memória.
 
  Creates the empty digraph/graph, case ptype is respectively 1 or 0. Returns the 
  reference to the new digraph/graph or NULL if there isn't enough memory.
@@ -57,7 +108,7 @@ PtDigraph Create (unsigned int ptype);
 
 int Destroy (PtDigraph *pdig);
 /*******************************************************************************
- Destri o dgrafo/grafo pdig e coloca a referncia a NULL. Valores de retorno:
+ Destrói o dígrafo/grafo pdig e coloca a referência a NULL. Valores de retorno:
  OK ou NO_DIGRAPH.
 
  Destroys the digraph/graph pdig and releases the memory. Returning error codes:
@@ -66,25 +117,43 @@ int Destroy (PtDigraph *pdig);
 
 PtDigraph Copy (PtDigraph pdig);
 /*******************************************************************************
- Copia o dgrafo/grafo pdig. Devolve a referncia da cpia ou NULL, caso no 
- consiga fazer a cpia por inexistncia de memria ou do dgrafo/grafo pdig.
+ Copia o dígrafo/grafo pdig. Devolve a referência da cópia ou NULL, caso não 
+ consiga fazer a cópia por inexistência de memória ou do dígrafo/grafo pdig.
+ Só os vértices são copiados (em tempo O(V)): a cópia partilha as listas de 
+ adjacências de pdig, com uma contagem de referências por vértice, e uma lista
+ só é clonada quando um dos dígrafos a altera. Um dígrafo com listas de arcos 
+ incidentes (DigraphSetIncoming) é copiado por inteiro. Cópia e original podem
+ ser alterados e destruídos em fios diferentes, e por qualquer ordem, e o mesmo
+ dígrafo/grafo pode ser copiado por vários fios ao mesmo tempo.
 
  Copies the digraph/graph pdig. Returns the reference to the new digraph/graph or
- NULL if there isn't enough memory or if pdig does not exist.
+ NULL if there isn't enough memory or if pdig does not exist. Only the vertexes 
+ are copied (in O(V) time): the copy shares the adjacency lists of pdig, with a
+ per-vertex reference count, and a list is only cloned when one of the digraphs
+ changes it. A digraph with incoming lists (DigraphSetIncoming) is fully copied.
+ The copy and the original can be changed and destroyed in different threads, 
+ in any order, and the same digraph/graph can be copied by several threads at
+ the same time.
 *******************************************************************************/
 
 int InVertex (PtDigraph pdig, unsigned int pv);
 /*******************************************************************************
- Insere o vrtice pv, no dgrafo/grafo pdig. Valores de retorno: OK, NO_DIGRAPH
- ou REP_VERTEX.
+ Insere o vértice pv, no dígrafo/grafo pdig. A posição na lista ordenada dos
+ vértices é encontrada num conjunto de bits com um resumo por palavra, pelo que
+ as inserções por ordem crescente ou decrescente são de tempo constante e um
+ intervalo de números sem vértice só custa uma palavra do resumo por cada 4096
+ números. Valores de retorno: OK, NO_DIGRAPH ou REP_VERTEX.
  
- Inserts vertex pv in digraph/graph pdig. Returning error codes: OK, NO_DIGRAPH
- or REP_VERTEX.
+ Inserts vertex pv in digraph/graph pdig. Its position in the sorted vertex list
+ is found in a bitset with a per-word summary, so inserting in ascending or 
+ descending order takes constant time and a gap of numbers without vertexes 
+ only costs one summary word per 4096 numbers. Returning error codes: OK, 
+ NO_DIGRAPH or REP_VERTEX.
 *******************************************************************************/
 
 int OutVertex (PtDigraph pdig, unsigned int pv);
 /*******************************************************************************
- Retira o vrtice pv, no dgrafo/grafo pdig. Retira tambm todas as suas arestas
+ Retira o vértice pv, no dígrafo/grafo pdig. Retira também todas as suas arestas
  incidentes e emergentes. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY ou 
  NO_VERTEX.
  
@@ -94,7 +163,7 @@ int OutVertex (PtDigraph pdig, unsigned int pv);
 
 int InEdge (PtDigraph pdig, unsigned int pv1, unsigned int pv2, int pcost);
 /*******************************************************************************
- Insere a aresta pv1-pv2, com custo pcost, no dgrafo/grafo pdig. Valores de 
+ Insere a aresta pv1-pv2, com custo pcost, no dígrafo/grafo pdig. Valores de 
  retorno: OK, NO_DIGRAPH, NO_VERTEX ou REP_EDGE.
  
  Inserts edge pv1-pv2 with cost pcost in digraph/graph pdig. Returning error codes:
@@ -103,25 +172,46 @@ int InEdge (PtDigraph pdig, unsigned int pv1, unsigned int pv2, int pcost);
 
 int OutEdge (PtDigraph pdig, unsigned int pv1, unsigned int pv2);
 /*******************************************************************************
- Retira a aresta pv1-pv2 do dgrafo/grafo pdig. Valores de retorno: OK, NO_DIGRAPH,
+ Retira a aresta pv1-pv2 do dígrafo/grafo pdig. Valores de retorno: OK, NO_DIGRAPH,
  NO_VERTEX ou NO_EDGE.
  
  Deletes edge pv1-pv2 from digraph/graph pdig. Returning error codes: OK, NO_DIGRAPH,
  NO_VERTEX or NO_EDGE.
 *******************************************************************************/
 
+int DigraphApplyBatch (PtDigraph pdig, EDGEOP pops[], unsigned int pn);
+/*******************************************************************************
+ Aplica ao dígrafo/grafo pdig as pn operações de pops, com o mesmo resultado que
+ InEdge e OutEdge chamadas pela ordem da sequência, mas agrupando as operações 
+ pelo vértice emergente e ordenando-as uma só vez, para que cada lista de 
+ adjacências seja percorrida e alterada numa única passagem. O código de erro de
+ cada operação (OK, NO_VERTEX, REP_EDGE ou NO_EDGE, como em InEdge e OutEdge) 
+ fica no seu campo Status. A memória das inserções é reservada antes de qualquer
+ alteração, pelo que, se faltar, nada é alterado. Valores de retorno: OK, 
+ NO_DIGRAPH, NULL_PTR ou NO_MEM.
+
+ Applies the pn operations of pops to digraph/graph pdig, with the same result as
+ InEdge and OutEdge called in the order of the array, but grouping the 
+ operations by source vertex and sorting them once, so that every adjacency list
+ is walked and changed in a single pass. The error code of each operation (OK, 
+ NO_VERTEX, REP_EDGE or NO_EDGE, as in InEdge and OutEdge) is stored in its 
+ Status field. The memory of the insertions is reserved before any change, so if
+ it runs out nothing is changed. Returning error codes: OK, NO_DIGRAPH, NULL_PTR
+ or NO_MEM.
+*******************************************************************************/
+
 int Type (PtDigraph pdig, unsigned int *pty);
 /*******************************************************************************
- Determina e coloca em pty o tipo do dgrafo/grafo pdig (dgrafo = 1/ grafo = 0).
+ Determina e coloca em pty o tipo do dígrafo/grafo pdig (dígrafo = 1/ grafo = 0).
  Valores de retorno: OK, NO_DIGRAPH ou NULL_PTR.
  
- Decide and stores in pty the type of the digraph/graph pdig (ddigraph = 1/ 
+ Decide and stores in pty the type of the digraph/graph pdig (dídigraph = 1/ 
  graph = 0). Returning error codes: OK, NO_DIGRAPH or NULL_PTR. 
 *******************************************************************************/
 
 int VertexNumber (PtDigraph pdig, unsigned int *pnv);
 /*******************************************************************************
- Determina e coloca em pnv o nmero de vrtices do dgrafo/grafo pdig. Valores 
+ Determina e coloca em pnv o número de vértices do dígrafo/grafo pdig. Valores 
  de retorno: OK, NO_DIGRAPH ou NULL_PTR.
  
  Decide and stores in pnv the number of vertexes of digraph/graph pdig.
@@ -130,7 +220,7 @@ int VertexNumber (PtDigraph pdig, unsigned int *pnv);
 
 int EdgeNumber (PtDigraph pdig, unsigned int *pne);
 /*******************************************************************************
- Determina e coloca em pne o nmero de arestas do dgrafo/grafo pdig. Valores de
+ Determina e coloca em pne o número de arestas do dígrafo/grafo pdig. Valores de
  retorno: OK, NO_DIGRAPH ou NULL_PTR.
  
  Decide and stores in pne the number of edges of digraph/graph pdig. Returning 
@@ -139,74 +229,366 @@ int EdgeNumber (PtDigraph pdig, unsigned int *pne);
 
 int GetVertexList (PtDigraph pdig, unsigned int ppos, char *pvlist);
 /*******************************************************************************
- Cria uma sequncia de carateres com a informao do ppos vrtice (1 <= ppos <= V),
- incluindo a sua lista de adjacncias, do dgrafo/grafo pdig. Esta operao  
- necessria para que uma aplicao grfica possa fazer a escrita do dgrafo/grafo
+ Cria uma sequência de carateres com a informação do ppos vértice (1 <= ppos <= V),
+ incluindo a sua lista de adjacências, do dígrafo/grafo pdig. Esta operação é 
+ necessária para que uma aplicação gráfica possa fazer a escrita do dígrafo/grafo
  no monitor de forma controlada. Valores de retorno: OK, NO_DIGRAPH ou NULL_PTR.
+ Para percorrer todos os vértices, usar os cursores (DigraphVertexBegin).
  
  Creates a string with the information of vertex ppos (1 <= ppos <= V),
  including its edges list, of digraph/graph pdig. This operation is necessary 
  in order that a graphical application pcan print the digraph/graph on the screen
  in a controlled way. Returning error codes: OK, NO_DIGRAPH or NULL_PTR.
+ To walk all the vertexes, use the cursors (DigraphVertexBegin).
+*******************************************************************************/
+
+int DigraphVertexBegin (PtDigraph pdig, DIGRAPHCURSOR *pcur);
+/*******************************************************************************
+ Coloca o cursor pcur, reservado pela aplicação, no início da lista de vértices
+ do dígrafo/grafo pdig, por ordem crescente do número. O cursor deixa de ser 
+ válido quando o dígrafo/grafo é alterado. Valores de retorno: OK, NO_DIGRAPH ou
+ NULL_PTR.
+
+ Places the cursor pcur, allocated by the application, at the beginning of the 
+ vertexes list of digraph/graph pdig, in increasing number order. The cursor is 
+ no longer valid after the digraph/graph is changed. Returning error codes: OK,
+ NO_DIGRAPH or NULL_PTR.
+*******************************************************************************/
+
+int DigraphVertexNext (DIGRAPHCURSOR *pcur, unsigned int *pv, unsigned int *pindeg, unsigned int *poutdeg);
+/*******************************************************************************
+ Coloca em pv, pindeg e poutdeg o número e os semigraus incidente e emergente do
+ vértice seguinte do cursor pcur e avança o cursor (pindeg e poutdeg podem ser 
+ NULL). Valores de retorno: OK, NULL_PTR ou NO_VERTEX, depois do último vértice.
+
+ Stores in pv, pindeg and poutdeg the number and the in and out degrees of the 
+ next vertex of cursor pcur and advances the cursor (pindeg and poutdeg can be 
+ NULL). Returning error codes: OK, NULL_PTR or NO_VERTEX, after the last vertex.
+*******************************************************************************/
+
+int DigraphEdgeBegin (PtDigraph pdig, unsigned int pv, DIGRAPHCURSOR *pcur);
+/*******************************************************************************
+ Coloca o cursor pcur, reservado pela aplicação, no início da lista de 
+ adjacências do vértice pv do dígrafo/grafo pdig, por ordem crescente do vértice
+ incidente. O cursor deixa de ser válido quando o dígrafo/grafo é alterado. 
+ Valores de retorno: OK, NO_DIGRAPH, NULL_PTR ou NO_VERTEX.
+
+ Places the cursor pcur, allocated by the application, at the beginning of the 
+ adjacency list of vertex pv of digraph/graph pdig, in increasing target order.
+ The cursor is no longer valid after the digraph/graph is changed. Returning 
+ error codes: OK, NO_DIGRAPH, NULL_PTR or NO_VERTEX.
+*******************************************************************************/
+
+int DigraphEdgeNext (DIGRAPHCURSOR *pcur, unsigned int *pv2, int *pcost);
+/*******************************************************************************
+ Coloca em pv2 e pcost o vértice incidente e o custo da aresta seguinte do 
+ cursor pcur e avança o cursor (pcost pode ser NULL). Valores de retorno: OK, 
+ NULL_PTR ou NO_EDGE, depois da última aresta.
+
+ Stores in pv2 and pcost the target vertex and the cost of the next edge of 
+ cursor pcur and advances the cursor (pcost can be NULL). Returning error codes:
+ OK, NULL_PTR or NO_EDGE, after the last edge.
 *******************************************************************************/
 
 PtDigraph CreateFile (char *pfilename);
 /*******************************************************************************
- Cria um dgrafo/grafo com o conteudo do ficheiro pfilename. Devolve a referncia
- do dgrafo/grafo criado ou NULL, no caso de inexistncia de memria ou do ficheiro.
+ Cria um dígrafo/grafo com o conteudo do ficheiro pfilename. Devolve a referência
+ do dígrafo/grafo criado ou NULL, no caso de inexistência de memória ou do ficheiro.
 
  Creates the digraph/graph from the file pfilename. Returns the reference to the 
  new digraph/graph or NULL if there isn't enough memory or if the file does not exist.
 *******************************************************************************/
 
+PtDigraph CreateStream (FILE *pstream, unsigned int ptype);
+/*******************************************************************************
+ Cria um dígrafo (1) /grafo (0) lendo o fluxo pstream (ficheiro ou pipe) por 
+ blocos de dimensão fixa, sem cabeçalho: cada linha tem uma aresta (v1 v2 custo),
+ um vértice isolado (v) ou está vazia. Os vértices são criados à medida que 
+ aparecem e os arcos acrescentados ao fim das listas, que só são ordenadas no 
+ fim, pelo que a memória usada é a do dígrafo/grafo final. Devolve a referência 
+ do dígrafo/grafo criado ou NULL, no caso de inexistência de memória, de linha 
+ inválida, de lacete ou de aresta repetida.
+
+ Creates a digraph (1) /graph (0) reading the stream pstream (file or pipe) in 
+ fixed-size chunks, without header: each line holds an edge (v1 v2 cost), an 
+ isolated vertex (v) or is empty. Vertexes are created on demand and arcs are 
+ appended to the lists, which are only sorted at the end, so the memory used is 
+ that of the final digraph/graph. Returns the reference to the new digraph/graph
+ or NULL if there isn't enough memory or on an invalid line, loop or repeated edge.
+*******************************************************************************/
+
 int StoreFile (PtDigraph pdig, char *pfilename);
 /*******************************************************************************
- Armazena o dgrafo/grafo pdig no ficheiro pfilename. Valores de retorno: OK, 
+ Armazena o dígrafo/grafo pdig no ficheiro pfilename. Valores de retorno: OK, 
  NO_DIGRAPH, DIGRAPH_EMPTY ou NO_FILE.
  
  Stores the digraph/graph pdig in file pfilename. Returning error codes: OK, 
  NO_DIGRAPH, DIGRAPH_EMPTY or NO_FILE.
 *******************************************************************************/
 
-int VertexType (PtDigraph pdig, unsigned int pv);
+PtQuery QueryCreate (PtDigraph pdig);
+/*******************************************************************************
+ Cria um contexto de consulta para o dígrafo/grafo pdig, com as marcas de vértice
+ visitado, os predecessores, os custos e a fila com prioridade usados pelas 
+ pesquisas. As marcas têm uma época, que avança em cada consulta, pelo que não é
+ preciso apagá-las entre consultas. Cada contexto só pode ser usado por um fio de
+ cada vez; fios com contextos diferentes podem consultar em simultâneo o mesmo
+ dígrafo/grafo, desde que este não seja alterado. Devolve a referência do 
+ contexto criado ou NULL, no caso de inexistência de memória ou do dígrafo/grafo.
+
+ Creates a query context for digraph/graph pdig, holding the visited marks, the
+ predecessors, the costs and the priority queue used by the searches. The marks
+ carry an epoch that advances on every query, so they never need to be cleared
+ between queries. Each context may only be used by one thread at a time; threads
+ with different contexts may query the same digraph/graph concurrently, as long
+ as it is not changed. Returns the reference to the new context or NULL if there
+ isn't enough memory or if pdig does not exist.
+*******************************************************************************/
+
+int QueryDestroy (PtQuery *pquery);
 /*******************************************************************************
- Determina de que tipo  o vertice pv. Valores de retorno: OK (vertice normal), 
- NO_DIGRAPH, DIGRAPH_EMPTY, NO_VERT, SINK (vertice sumidouro), SOURCE (vertice 
- fonte) ou DISC (vertice desconexo).
+ Destrói o contexto de consulta pquery e coloca a referência a NULL. Valores de
+ retorno: OK ou NULL_PTR.
 
- Decide the type of vertex pv of digraph/graph pdig. Returning error codes:
- OK (normal vertex, NO_DIGRAPH, DIGRAPH_EMPTY, NO_VERT, SINK (sink vertex), SOURCE
- (source vertex) ou DISC (disconnected vertex).
+ Destroys the query context pquery and releases the memory. Returning error 
+ codes: OK or NULL_PTR.
 *******************************************************************************/
 
-int Dijkstra (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[]);
+int VertexType (PtDigraph pdig, unsigned int pv, PtQuery pquery);
 /*******************************************************************************
- Determina os caminhos mais curtos dos vertices alcanveis a partir do vertice pv.
+ Determina de que tipo é o vertice pv. O contexto pquery é opcional (NULL) e não
+ é usado, porque o tipo resulta dos semigraus. Valores de retorno: OK (vertice 
+ normal), NO_DIGRAPH, DIGRAPH_EMPTY, NO_VERT, SINK (vertice sumidouro), SOURCE 
+ (vertice fonte) ou DISC (vertice desconexo).
+
+ Decide the type of vertex pv of digraph/graph pdig. The context pquery is 
+ optional (NULL) and unused, since the type follows from the degrees. Returning
+ error codes: OK (normal vertex, NO_DIGRAPH, DIGRAPH_EMPTY, NO_VERT, SINK (sink 
+ vertex), SOURCE (source vertex) ou DISC (disconnected vertex).
+*******************************************************************************/
+
+int Dijkstra (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[], PtQuery pquery);
+/*******************************************************************************
+ Determina os caminhos mais curtos dos vertices alcançáveis a partir do vertice pv.
  Devolve a lista de vertices predecessores em pvpred e os respectivos custos dos
- caminhos em pvcost. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR
- ou NO_VERT.
+ caminhos em pvcost. Exige custos não negativos; com custos negativos deve usar-se
+ BellmanFord ou ShortestPaths. Usa o contexto de consulta pquery ou, se for NULL,
+ um contexto temporário. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, 
+ NULL_PTR, NO_VERT ou NO_MEM.
  
  Determines the shortest paths of all reachable vertexes from vertex pv. Stores
  the predecessor vertexes in array pvpred and the respective costs in array pvcost.
- Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR or NO_VERT.
+ Requires non-negative costs; with negative costs use BellmanFord or ShortestPaths.
+ Uses the query context pquery or, if it is NULL, a temporary context. Returning
+ error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERT or NO_MEM.
+*******************************************************************************/
+
+int BellmanFord (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[], PtQuery pquery);
+/*******************************************************************************
+ Determina os caminhos mais curtos dos vertices alcançáveis a partir do vertice pv
+ com o algoritmo de Bellman-Ford com fila (SPFA), que aceita custos negativos.
+ Devolve os resultados em pvpred e pvcost como Dijkstra. Se um ciclo de custo 
+ negativo for alcançável a partir de pv, a pesquisa pára logo que o deteta e as
+ sequências não são alteradas. Usa o contexto de consulta pquery ou, se for NULL,
+ um contexto temporário. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, 
+ NULL_PTR, NO_VERT, NEG_CYCLE ou NO_MEM.
+ 
+ Determines the shortest paths of all reachable vertexes from vertex pv with the
+ queue-based Bellman-Ford algorithm (SPFA), which accepts negative costs. Stores
+ the results in pvpred and pvcost like Dijkstra. If a negative cost cycle is 
+ reachable from pv, the search stops as soon as it detects it and the arrays are
+ left unchanged. Uses the query context pquery or, if it is NULL, a temporary 
+ context. Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERT,
+ NEG_CYCLE or NO_MEM.
+*******************************************************************************/
+
+int ShortestPaths (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[], PtQuery pquery);
+/*******************************************************************************
+ Determina os caminhos mais curtos dos vertices alcançáveis a partir do vertice pv,
+ escolhendo Dijkstra se todos os custos do dígrafo/grafo são não negativos ou,
+ no caso contrário, DigraphDAGShortest se for um dígrafo acíclico e BellmanFord
+ se não for. O número de arcos de custo negativo é mantido pelas inserções e 
+ remoções. Num grafo, uma aresta de custo negativo é um ciclo negativo. Valores
+ de retorno: os de Dijkstra, de DigraphDAGShortest e de BellmanFord.
+ 
+ Determines the shortest paths of all reachable vertexes from vertex pv, choosing
+ Dijkstra if all costs of digraph/graph pdig are non-negative or, otherwise,
+ DigraphDAGShortest if it is an acyclic digraph and BellmanFord if it is not. 
+ The number of negative cost arcs is kept by insertions and removals.
+ On a graph, a negative cost edge is a negative cycle. Returning error codes: 
+ those of Dijkstra, DigraphDAGShortest and BellmanFord.
+*******************************************************************************/
+
+int DigraphTopologicalSort (PtDigraph pdig, unsigned int porder[]);
+/*******************************************************************************
+ Determina uma ordem topológica do dígrafo acíclico pdig, com o algoritmo de Kahn
+ sobre os semigraus incidentes. Devolve os vértices em porder, sendo que a posição
+ 0 da sequência indica o número de vértices. A ordem fica em cache no dígrafo até
+ à próxima alteração (InVertex, OutVertex, InEdge, OutEdge, ...), pelo que as 
+ consultas seguintes não a voltam a calcular. Num grafo, qualquer aresta é um 
+ ciclo. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_DAG ou 
+ NO_MEM.
+ 
+ Determines a topological order of the acyclic digraph pdig, with Kahn's 
+ algorithm over the in degrees. Stores the vertexes in array porder, with the 
+ number of vertexes stored in position 0. The order is cached on the digraph 
+ until the next change (InVertex, OutVertex, InEdge, OutEdge, ...), so later 
+ queries do not compute it again. On a graph, any edge is a cycle. Returning 
+ error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_DAG or NO_MEM.
+*******************************************************************************/
+
+int DigraphDAGShortest (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[]);
+/*******************************************************************************
+ Determina os caminhos mais curtos dos vertices alcançáveis a partir do vertice pv
+ no dígrafo acíclico pdig, relaxando os arcos pela ordem topológica, em tempo 
+ linear e com custos de qualquer sinal. Devolve os resultados em pvpred e pvcost
+ como Dijkstra. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, 
+ NO_VERTEX, NO_DAG ou NO_MEM.
+ 
+ Determines the shortest paths of all reachable vertexes from vertex pv on the
+ acyclic digraph pdig, relaxing the arcs in topological order, in linear time and
+ with costs of any sign. Stores the results in pvpred and pvcost like Dijkstra.
+ Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX, NO_DAG
+ or NO_MEM.
+*******************************************************************************/
+
+int DigraphDAGLongest (PtDigraph pdig, unsigned int pv, unsigned int pvpred[], int pvcost[]);
+/*******************************************************************************
+ Determina os caminhos mais longos dos vertices alcançáveis a partir do vertice pv
+ no dígrafo acíclico pdig (por exemplo, o caminho crítico de um escalonamento), 
+ como DigraphDAGShortest. Os vértices não alcançáveis ficam com predecessor 0 e
+ custo INT_MAX. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, 
+ NO_VERTEX, NO_DAG ou NO_MEM.
+ 
+ Determines the longest paths of all reachable vertexes from vertex pv on the 
+ acyclic digraph pdig (for instance, the critical path of a schedule), like 
+ DigraphDAGShortest. Unreachable vertexes get predecessor 0 and cost INT_MAX.
+ Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX, NO_DAG
+ or NO_MEM.
+*******************************************************************************/
+
+int DigraphSetPQueue (PtDigraph pdig, unsigned int pkind);
+/*******************************************************************************
+ Escolhe a fila com prioridade usada pelo algoritmo de Dijkstra no dígrafo/grafo
+ pdig e nos seus instantâneos CSR criados a seguir: DIJKSTRA_BINARY (amontoado 
+ binário, por omissão) ou DIJKSTRA_RADIX (amontoado radix, que exige custos não
+ negativos). Qualquer outro valor escolhe o amontoado binário. Valores de 
+ retorno: OK ou NO_DIGRAPH.
+
+ Chooses the priority queue used by Dijkstra's algorithm on digraph/graph pdig
+ and on its CSR snapshots created afterwards: DIJKSTRA_BINARY (binary heap, the
+ default) or DIJKSTRA_RADIX (radix heap, which requires non-negative costs). Any
+ other value chooses the binary heap. Returning error codes: OK or NO_DIGRAPH.
+*******************************************************************************/
+
+int DigraphSetIncoming (PtDigraph pdig, unsigned int pon);
+/*******************************************************************************
+ Liga (pon diferente de 0) ou desliga (pon igual a 0) as listas de arcos 
+ incidentes do dígrafo pdig, mantidas por InEdge e OutEdge a par das listas de 
+ adjacências, com um binó gémeo por arco. Com elas, OutVertex remove os arcos 
+ incidentes em tempo proporcional ao grau do vértice, em vez de percorrer todo o
+ dígrafo, e a pesquisa inversa de DigraphShortestPath dispensa o índice inverso.
+ Ligar as listas constrói-as de uma só vez. Num grafo, as listas de adjacências
+ já servem nos dois sentidos e nada é construído. As cópias herdam a opção. 
+ Valores de retorno: OK, NO_DIGRAPH ou NO_MEM.
+
+ Turns on (pon other than 0) or off (pon equal to 0) the incoming arc lists of
+ digraph pdig, kept by InEdge and OutEdge alongside the adjacency lists, with a
+ twin node per arc. With them, OutVertex removes the incoming arcs in time 
+ proportional to the vertex degree, instead of scanning the whole digraph, and
+ the backward search of DigraphShortestPath needs no reverse index. Turning the
+ lists on builds them at once. On a graph, the adjacency lists already work in
+ both directions and nothing is built. Copies inherit the option. Returning 
+ error codes: OK, NO_DIGRAPH or NO_MEM.
 *******************************************************************************/
 
-int Reach (PtDigraph pdig, unsigned int pv, unsigned int pvlist[]);
+int DigraphSetConnectivity (PtDigraph pdig, unsigned int pon);
 /*******************************************************************************
- Determina os vertices alcanveis a partir a partir do vertice pv. Devolve a 
- lista de vertices em pvlist, sendo que a posio 0 da sequncia indica o numero
- de vertices alcanveis. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, 
+ Liga (pon diferente de 0) ou desliga (pon igual a 0) a manutenção da partição
+ união-procura das componentes conexas do dígrafo/grafo pdig usada por 
+ DigraphConnected e DigraphComponents. Ligada, InVertex e InEdge atualizam a 
+ partição em tempo quase constante; as remoções e as outras alterações apenas a
+ invalidam e a partição é reconstruída, uma só vez, na consulta seguinte. 
+ Desligada, a partição é reconstruída na primeira consulta depois de cada 
+ alteração. Valores de retorno: OK ou NO_DIGRAPH.
+
+ Turns on (pon other than 0) or off (pon equal to 0) the maintenance of the 
+ union-find partition of the connected components of digraph/graph pdig used by
+ DigraphConnected and DigraphComponents. When on, InVertex and InEdge update the
+ partition in nearly constant time; removals and the other changes just 
+ invalidate it and the partition is rebuilt, once, by the next query. When off,
+ the partition is rebuilt by the first query after each change. Returning error
+ codes: OK or NO_DIGRAPH.
+*******************************************************************************/
+
+int DigraphAllPairs (PtDigraph pdig, unsigned int pnthreads, unsigned int ppred[], int pcost[]);
+/*******************************************************************************
+ Determina os caminhos mais curtos entre todos os pares de vértices, executando 
+ o algoritmo de Dijkstra a partir de cada vértice em pnthreads fios (0 para um
+ fio por processador), cada um com o seu contexto de consulta.
+ As matrizes ppred e pcost, de N×N elementos, sendo N o maior número de vértice,
+ recebem por linhas o resultado de Dijkstra: a linha v-1 tem os predecessores e
+ os custos a partir do vértice v. O dígrafo/grafo não pode ser alterado durante
+ a execução. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR ou NO_MEM.
+
+ Determines the shortest paths between all pairs of vertexes, running Dijkstra's
+ algorithm from every vertex on pnthreads threads (0 for one thread per processor),
+ each with its own query context. The N×N matrices ppred and pcost,
+ where N is the highest vertex number, receive Dijkstra's result by rows: row v-1
+ holds the predecessors and costs from vertex v. The digraph/graph must not be
+ changed while it runs. Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, 
+ NULL_PTR or NO_MEM.
+*******************************************************************************/
+
+int DigraphShortestPath (PtDigraph pdig, unsigned int psrc, unsigned int pdst, unsigned int ppath[], int *pcost, PtHeuristic pheuristic, void *pdata, PtQuery pquery);
+/*******************************************************************************
+ Determina o caminho mais curto do vértice psrc para o vértice pdst, sem calcular
+ os caminhos para os restantes vértices. Sem heurística (pheuristic a NULL), faz
+ uma pesquisa de Dijkstra bidirecional, usando num dígrafo um índice inverso dos
+ arcos incidentes (construído na primeira consulta depois de cada alteração), e
+ pára logo que as duas fronteiras se cruzam. Com heurística, faz uma pesquisa A*
+ ordenada pelo custo mais pheuristic (v, pdst, pdata), que tem de ser uma 
+ estimativa admissível (nunca superior ao custo real) do custo de v até pdst; a
+ pesquisa A* usa sempre o amontoado binário, qualquer que seja a fila escolhida
+ com DigraphSetPQueue. Devolve o caminho em ppath, com o número de vértices na
+ posição 0 seguido dos vértices de psrc até pdst, e o seu custo em pcost. Usa o
+ contexto de consulta pquery ou, se for NULL, um contexto temporário. Valores de
+ retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX, NO_PATH ou NO_MEM.
+
+ Determines the shortest path from vertex psrc to vertex pdst, without computing
+ the paths to the other vertexes. Without a heuristic (pheuristic is NULL), runs
+ a bidirectional Dijkstra search, using on a digraph a reverse index of the 
+ incoming arcs (built by the first query after each change), and stops as soon as
+ both frontiers meet. With a heuristic, runs an A* search ordered by the cost plus
+ pheuristic (v, pdst, pdata), which must be an admissible estimate (never above
+ the real cost) of the cost from v to pdst; the A* search always uses the binary
+ heap, whatever queue was chosen with DigraphSetPQueue. Stores the path in 
+ ppath, with the number of vertexes in position 0 followed by the vertexes from
+ psrc to pdst, and its cost in pcost. Uses the query context pquery or, if it is
+ NULL, a temporary context. Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY,
+ NULL_PTR, NO_VERTEX, NO_PATH or NO_MEM.
+*******************************************************************************/
+
+int Reach (PtDigraph pdig, unsigned int pv, unsigned int pvlist[], PtQuery pquery);
+/*******************************************************************************
+ Determina os vertices alcançáveis a partir a partir do vertice pv, com uma 
+ pesquisa em largura sem pesos. Devolve a lista de vertices em pvlist, por ordem
+ crescente e sem o próprio pv, sendo que a posição 0 da sequência indica o numero
+ de vertices alcançáveis. Usa o contexto de consulta pquery ou, se for NULL, um
+ contexto temporário. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, 
  NULL_PTR, NO_VERT ou NO_MEM.
  
- Determines all reachable vertexes from vertex pv. Stores the vertexes in array
- pvlist, with the number of reachable vertexes stored in the position 0. Returning
- error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERT or NO_MEM.
+ Determines all reachable vertexes from vertex pv, with an unweighted breadth-first
+ search. Stores the vertexes in array pvlist, in ascending order and without pv
+ itself, with the number of reachable vertexes stored in the position 0. Uses the
+ query context pquery or, if it is NULL, a temporary context. Returning error 
+ codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERT or NO_MEM.
 *******************************************************************************/
 
 int DigraphRegular (PtDigraph pdig, unsigned int *preg);
 /*******************************************************************************
- Determina se o dgrafo pdig  regular. Coloca 1 em caso afirmativo e 0 no caso
- contrrio no parmetro pcomp. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY
+ Determina se o dígrafo pdig é regular. Coloca 1 em caso afirmativo e 0 no caso
+ contrário no parâmetro pcomp. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY
  ou NULL_PTR.
  
  Verifies if digraph/graph pdig is a regular digraph/graph. Stores 1 in 
@@ -216,9 +598,9 @@ int DigraphRegular (PtDigraph pdig, unsigned int *preg);
 
 PtDigraph DigraphComplement (PtDigraph pdig);
 /*******************************************************************************
- Cria o dgrafo complementar do dgrafo pdig. Devolve a referncia do dgrafo 
- criado ou NULL, no caso de inexistncia de memria ou do dgrafo/grafo pdig.
- Considere as arestas com custo unitrio.
+ Cria o dígrafo complementar do dígrafo pdig. Devolve a referência do dígrafo 
+ criado ou NULL, no caso de inexistência de memória ou do dígrafo/grafo pdig.
+ Considere as arestas com custo unitário.
 
  Creates the complement of digraph/graph pdig. Returns the reference to the new
  digraph/graph or NULL if there isn't enough memory or if the pdig does not exist.
@@ -227,19 +609,85 @@ PtDigraph DigraphComplement (PtDigraph pdig);
 
 int DigraphStronglyConnected (PtDigraph pdig, unsigned int *pstrong);
 /*******************************************************************************
- Verifica se o dgrafo pdig  fortemente conexo. Coloca 1 em caso afirmativo e 0
- no caso contrrio no parmetro pstrong. Valores de retorno: OK, NO_DIGRAPH, 
+ Verifica se o dígrafo pdig é fortemente conexo, com uma única determinação das
+ componentes fortemente conexas. Coloca 1 em caso afirmativo e 0 no caso 
+ contrário no parâmetro pstrong. Valores de retorno: OK, NO_DIGRAPH, 
  DIGRAPH_EMPTY, NO_MEM ou NULL_PTR.
  
- Verifies if digraph pdig is strongly connected. Stores 1 in affirmative case and
- 0 otherwise in parameter pstrong. Returning error codes: OK, NO_DIGRAPH, 
+ Verifies if digraph pdig is strongly connected, with a single pass computing
+ the strongly connected components. Stores 1 in affirmative case and 0 otherwise
+ in parameter pstrong. Returning error codes: OK, NO_DIGRAPH, 
  DIGRAPH_EMPTY, NO_MEM or NULL_PTR.
 *******************************************************************************/
 
+int DigraphSCC (PtDigraph pdig, unsigned int comp[], unsigned int *ncomp);
+/*******************************************************************************
+ Determina as componentes fortemente conexas do dígrafo pdig em tempo linear 
+ (algoritmo de Tarjan iterativo, sem limite de profundidade de recursividade).
+ Coloca em comp[v-1] o número (de 1 a *ncomp) da componente de cada vértice v e
+ em ncomp o número de componentes. As componentes são numeradas por ordem 
+ topológica do dígrafo condensado, pelo que todas as arestas entre componentes 
+ vão de uma componente para outra de número superior. Valores de retorno: OK, 
+ NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR ou NO_MEM.
+
+ Determines the strongly connected components of digraph pdig in linear time 
+ (iterative Tarjan's algorithm, without recursion depth limit). Stores in 
+ comp[v-1] the number (from 1 to *ncomp) of the component of each vertex v and 
+ in ncomp the number of components. The components are numbered in topological 
+ order of the condensed digraph, so every edge between components goes to a 
+ component with a higher number. Returning error codes: OK, NO_DIGRAPH, 
+ DIGRAPH_EMPTY, NULL_PTR or NO_MEM.
+*******************************************************************************/
+
+int DigraphConnected (PtDigraph pdig, unsigned int pv1, unsigned int pv2, unsigned int *pconn);
+/*******************************************************************************
+ Verifica se os vértices pv1 e pv2 pertencem à mesma componente conexa do grafo
+ pdig (num dígrafo, à mesma componente fracamente conexa), em tempo quase 
+ constante entre alterações (ver DigraphSetConnectivity). Coloca 1 em caso 
+ afirmativo e 0 no caso contrário no parâmetro pconn. Valores de retorno: OK,
+ NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX ou NO_MEM.
+
+ Verifies if vertexes pv1 and pv2 belong to the same connected component of 
+ graph pdig (on a digraph, to the same weakly connected component), in nearly 
+ constant time between changes (see DigraphSetConnectivity). Stores 1 in 
+ affirmative case and 0 otherwise in parameter pconn. Returning error codes: OK,
+ NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX or NO_MEM.
+*******************************************************************************/
+
+int DigraphComponents (PtDigraph pdig, unsigned int comp[], unsigned int *ncomp);
+/*******************************************************************************
+ Determina as componentes conexas do grafo pdig (num dígrafo, as componentes
+ fracamente conexas) a partir da mesma partição de DigraphConnected. Coloca em
+ comp[v-1] o número (de 1 a *ncomp) da componente de cada vértice v, numeradas
+ pela ordem do seu vértice de menor número, e em ncomp o número de componentes.
+ Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR ou NO_MEM.
+
+ Determines the connected components of graph pdig (on a digraph, the weakly 
+ connected components) from the same partition as DigraphConnected. Stores in 
+ comp[v-1] the number (from 1 to *ncomp) of the component of each vertex v, 
+ numbered by their lowest numbered vertex, and in ncomp the number of components.
+ Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR or NO_MEM.
+*******************************************************************************/
+
+PtDigraph DigraphCondensation (PtDigraph pdig);
+/*******************************************************************************
+ Cria o dígrafo condensado (acíclico) do dígrafo pdig, com um vértice por cada
+ componente fortemente conexa, numerado como em DigraphSCC, e uma aresta de custo
+ unitário entre duas componentes sempre que existe uma aresta entre vértices 
+ delas. Devolve a referência do dígrafo criado ou NULL, no caso de inexistência
+ de memória ou do dígrafo/grafo pdig, ou se pdig estiver vazio.
+
+ Creates the (acyclic) condensation of digraph pdig, with one vertex for each 
+ strongly connected component, numbered as in DigraphSCC, and a unity cost edge
+ between two components whenever there is an edge between their vertexes. 
+ Returns the reference to the new digraph or NULL if there isn't enough memory,
+ if pdig does not exist or if it is empty.
+*******************************************************************************/
+
 int DigraphTransitiveClosure (PtDigraph pdig);
 /*******************************************************************************
- Implementa o fecho transitivo do dgrafo pdig no prprio dgrafo. Considere as 
- novas arestas com custo unitrio. Valores de retorno: OK, NO_DIGRAPH, 
+ Implementa o fecho transitivo do dígrafo pdig no próprio dígrafo. Considere as 
+ novas arestas com custo unitário. Valores de retorno: OK, NO_DIGRAPH, 
  DIGRAPH_EMPTY ou NO_MEM.
 
  Implements the transitive closure of digraph pdig in digraph itself. Considere 
@@ -247,4 +695,204 @@ int DigraphTransitiveClosure (PtDigraph pdig);
  DIGRAPH_EMPTY or NO_MEM.
 *******************************************************************************/
 
+/************************* Árvore Geradora Mínima *************************/
+
+int DigraphMST (PtDigraph pdig, unsigned int palg, PtDigraph *ptree, unsigned int pedges[], int *pcost);
+/*******************************************************************************
+ Determina a árvore geradora mínima do grafo pdig com o algoritmo palg: MST_PRIM
+ (amontoado binário indexado da fila de Dijkstra) ou MST_KRUSKAL (ordenação radix
+ paralela das arestas pelo custo e partição união-procura). Num dígrafo, os arcos
+ são tratados como arestas. Coloca o custo total em pcost e, se não forem NULL, 
+ um novo grafo com os vértices de pdig e as arestas da árvore em ptree e a lista
+ de arestas em pedges: a posição 0 indica o número de arestas, seguido dos pares
+ de vértices de cada aresta (2×(V-1) posições). Se o grafo não for conexo, 
+ devolve NO_CONNECTED com a floresta geradora mínima (uma árvore por componente)
+ nos mesmos parâmetros. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, 
+ NULL_PTR, NO_CONNECTED ou NO_MEM.
+
+ Determines the minimum spanning tree of graph pdig with algorithm palg: MST_PRIM
+ (indexed binary heap of Dijkstra's queue) or MST_KRUSKAL (parallel radix sort
+ of the edges by cost and union-find partition). On a digraph, the arcs are 
+ taken as edges. Stores the total cost in pcost and, if they are not NULL, a new
+ graph with the vertexes of pdig and the edges of the tree in ptree and the edge
+ list in pedges: position 0 holds the number of edges, followed by the vertex 
+ pairs of every edge (2×(V-1) positions). If the graph is not connected, returns
+ NO_CONNECTED with the minimum spanning forest (one tree per component) in the
+ same parameters. Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR,
+ NO_CONNECTED or NO_MEM.
+*******************************************************************************/
+
+/******************* Instantâneo CSR (Compressed Sparse Row) *******************/
+
+PtDigraphCSR DigraphFreeze (PtDigraph pdig);
+/*******************************************************************************
+ Cria um instantâneo imutável do dígrafo/grafo pdig no formato CSR (Compressed
+ Sparse Row), com as listas de adjacências e os custos armazenados em sequências
+ contíguas e com o acesso direto dos números dos vértices aos seus índices. As
+ alterações posteriores de pdig não se refletem no instantâneo. Devolve a 
+ referência do instantâneo criado ou NULL, no caso de inexistência de memória
+ ou do dígrafo/grafo pdig.
+
+ Creates an immutable snapshot of digraph/graph pdig in CSR (Compressed Sparse
+ Row) format, with the adjacency lists and costs stored in contiguous arrays and
+ a direct map from vertex numbers to dense indexes. Later changes to pdig are
+ not reflected in the snapshot. Returns the reference to the new snapshot or NULL
+ if there isn't enough memory or if pdig does not exist.
+*******************************************************************************/
+
+int CSRDestroy (PtDigraphCSR *pcsr);
+/*******************************************************************************
+ Destrói o instantâneo pcsr e coloca a referência a NULL. Valores de retorno:
+ OK ou NO_DIGRAPH.
+
+ Destroys the snapshot pcsr and releases the memory. Returning error codes: OK 
+ or NO_DIGRAPH.
+*******************************************************************************/
+
+int CSRDijkstra (PtDigraphCSR pcsr, unsigned int pv, unsigned int pvpred[], int pvcost[]);
+/*******************************************************************************
+ Versão de Dijkstra sobre o instantâneo pcsr, com o mesmo contrato das sequências
+ pvpred e pvcost. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR,
+ NO_VERTEX ou NO_MEM.
+
+ Dijkstra over the snapshot pcsr, with the same contract for arrays pvpred and
+ pvcost. Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX
+ or NO_MEM.
+*******************************************************************************/
+
+int CSRReach (PtDigraphCSR pcsr, unsigned int pv, unsigned int pvlist[]);
+/*******************************************************************************
+ Versão de Reach sobre o instantâneo pcsr, com o mesmo contrato da sequência 
+ pvlist. Valores de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX
+ ou NO_MEM.
+
+ Reach over the snapshot pcsr, with the same contract for array pvlist. Returning
+ error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX or NO_MEM.
+*******************************************************************************/
+
+int CSRStronglyConnected (PtDigraphCSR pcsr, unsigned int *pstrong);
+/*******************************************************************************
+ Versão de DigraphStronglyConnected sobre o instantâneo pcsr, com duas pesquisas
+ em largura (direta e inversa) a partir do primeiro vértice. Valores de retorno:
+ OK, NO_DIGRAPH, DIGRAPH_EMPTY, NO_MEM ou NULL_PTR.
+
+ DigraphStronglyConnected over the snapshot pcsr, using two breadth-first 
+ searches (forward and backward) from the first vertex. Returning error codes:
+ OK, NO_DIGRAPH, DIGRAPH_EMPTY, NO_MEM or NULL_PTR.
+*******************************************************************************/
+
+PtDigraphCSR CSRTransitiveClosure (PtDigraphCSR pcsr);
+/*******************************************************************************
+ Cria um novo instantâneo com o fecho transitivo do instantâneo pcsr. As arestas
+ existentes mantêm o seu custo e as novas arestas têm custo unitário. Devolve a
+ referência do instantâneo criado ou NULL, no caso de inexistência de memória ou
+ do instantâneo pcsr.
+
+ Creates a new snapshot with the transitive closure of snapshot pcsr. Existing
+ edges keep their cost and the new edges have unity cost. Returns the reference
+ to the new snapshot or NULL if there isn't enough memory or if pcsr does not exist.
+*******************************************************************************/
+
+int CSRBreadthFirst (PtDigraphCSR pcsr, unsigned int pv, unsigned int pnthreads, unsigned int pvpred[], int pvcost[]);
+/*******************************************************************************
+ Pesquisa em largura paralela sobre o instantâneo pcsr a partir do vértice pv,
+ em pnthreads fios (0 para um fio por processador), que ignora os custos dos 
+ arcos. Devolve em pvpred e pvcost, com o contrato de Dijkstra, a árvore da
+ pesquisa e o número de arcos do caminho mais curto até cada vértice alcançável.
+ Cada nível é expandido de forma descendente (a partir da fronteira) ou 
+ ascendente (cada vértice por alcançar procura um predecessor na fronteira), 
+ conforme a dimensão da fronteira; num dígrafo, o primeiro nível ascendente 
+ constrói as adjacências inversas, que ficam guardadas no instantâneo. Valores 
+ de retorno: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR, NO_VERTEX ou NO_MEM.
+
+ Parallel breadth-first search over the snapshot pcsr from vertex pv, on 
+ pnthreads threads (0 for one thread per processor), ignoring the arc costs.
+ Stores in pvpred and pvcost, with Dijkstra's contract, the search tree and the
+ number of arcs of the shortest path to each reachable vertex. Each level is
+ expanded top-down (from the frontier) or bottom-up (each unreached vertex looks
+ for a predecessor in the frontier), depending on the size of the frontier; on
+ a digraph, the first bottom-up level builds the incoming adjacencies, which are
+ kept in the snapshot. Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, 
+ NULL_PTR, NO_VERTEX or NO_MEM.
+*******************************************************************************/
+
+/************************* Reordenação dos Vértices *************************/
+
+int DigraphReorder (PtDigraph pdig, unsigned int pstrategy, unsigned int pperm[]);
+/*******************************************************************************
+ Renumera os vértices do dígrafo/grafo pdig de 1 a V, por uma ordem que aproxima
+ os vizinhos: REORDER_BFS (pesquisa em largura), REORDER_RCM (Cuthill-McKee 
+ inversa) ou REORDER_DEGREE (grau decrescente). Os binós são reconstruídos pela 
+ nova ordem, pelo que as sequências indexadas pelo número (custos e predecessores
+ de Dijkstra, Reach) e as listas são percorridas com acessos próximos. Coloca em 
+ pperm (com V elementos) o número antigo de cada novo vértice: pperm[K-1] é o 
+ número antigo do vértice K. Os cursores e os instantâneos CSR anteriores deixam
+ de corresponder ao dígrafo/grafo. Valores de retorno: OK, NO_DIGRAPH, 
+ DIGRAPH_EMPTY, NULL_PTR ou NO_MEM.
+
+ Renumbers the vertexes of digraph/graph pdig from 1 to V, in an order that keeps 
+ neighbours close: REORDER_BFS (breadth-first search), REORDER_RCM (reverse 
+ Cuthill-McKee) or REORDER_DEGREE (decreasing degree). The nodes are rebuilt in 
+ the new order, so the arrays indexed by number (Dijkstra's costs and predecessors,
+ Reach) and the lists are walked with nearby accesses. Stores in pperm (with V 
+ elements) the old number of each new vertex: pperm[K-1] is the old number of 
+ vertex K. Previous cursors and CSR snapshots no longer match the digraph/graph.
+ Returning error codes: OK, NO_DIGRAPH, DIGRAPH_EMPTY, NULL_PTR or NO_MEM.
+*******************************************************************************/
+
+PtDigraphCSR CSRReorder (PtDigraphCSR pcsr, unsigned int pstrategy, unsigned int pperm[]);
+/*******************************************************************************
+ Cria um instantâneo CSR com os vértices do instantâneo pcsr renumerados de 1 a V
+ pela estratégia pstrategy (ver DigraphReorder), e coloca em pperm o número 
+ antigo de cada novo vértice. Devolve a referência do instantâneo criado ou NULL,
+ no caso de inexistência de memória ou de pcsr estar vazio.
+
+ Creates a CSR snapshot with the vertexes of snapshot pcsr renumbered from 1 to V
+ with strategy pstrategy (see DigraphReorder), and stores in pperm the old number
+ of each new vertex. Returns the reference to the new snapshot or NULL if there 
+ isn't enough memory or if pcsr is empty.
+*******************************************************************************/
+
+/************************* Ficheiro Binário CSR *************************/
+
+int CSRStoreFile (PtDigraphCSR pcsr, char *pfilename);
+/*******************************************************************************
+ Armazena o instantâneo pcsr no ficheiro binário pfilename (formato versionado:
+ cabeçalho, números dos vértices, inícios das adjacências, vértices incidentes,
+ custos e acesso direto aos índices, na ordem dos bytes da máquina). Valores de
+ retorno: OK, NO_DIGRAPH ou NO_FILE.
+
+ Stores the snapshot pcsr in the binary file pfilename (versioned format: header,
+ vertex numbers, adjacency offsets, targets, costs and the number to index map,
+ in machine byte order). Returning error codes: OK, NO_DIGRAPH or NO_FILE.
+*******************************************************************************/
+
+PtDigraphCSR CSRMapFile (char *pfilename);
+/*******************************************************************************
+ Projeta em memória, só para leitura, o ficheiro binário pfilename e usa-o
+ diretamente como instantâneo CSR, sem o ler nem converter; apenas verifica, em
+ tempo linear, que as sequências são coerentes. O ficheiro fica projetado até
+ CSRDestroy. Devolve a referência do instantâneo ou NULL, se o ficheiro não 
+ existir, não tiver o formato ou a versão esperados, estiver truncado ou 
+ corrompido ou se não houver memória.
+
+ Maps the binary file pfilename read-only into memory and uses it directly as a
+ CSR snapshot, without reading or converting it; it only checks, in linear time,
+ that the arrays are consistent. The file stays mapped until CSRDestroy. Returns
+ the reference to the snapshot or NULL if the file does not exist, has an 
+ unexpected format or version, is truncated or corrupted, or if there isn't 
+ enough memory.
+*******************************************************************************/
+
+int ConvertFile (char *ptextname, char *pbinname);
+/*******************************************************************************
+ Converte o ficheiro de texto ptextname (formato de CreateFile) no ficheiro 
+ binário pbinname (formato de CSRStoreFile). Valores de retorno: OK, NO_FILE 
+ (ficheiro de texto inexistente ou inválido, ou erro de escrita) ou NO_MEM.
+
+ Converts the text file ptextname (CreateFile format) into the binary file
+ pbinname (CSRStoreFile format). Returning error codes: OK, NO_FILE (missing or
+ invalid text file, or write error) or NO_MEM.
+*******************************************************************************/
+
 #endif
@@ -1,43 +1,87 @@
-/******* Implementao da Fila com Prioridade com um Amontoado Binrio ********/
-/***** Fila com Prioridade orientada aos mnimos Nome: pqueue_dijkstra.c  *****/
+/** Implementação da Fila com Prioridade com um Amontoado Binário ou Radix **/
+/***** Fila com Prioridade orientada aos mínimos Nome: pqueue_dijkstra.c  *****/
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include "pqueue_dijkstra.h"  /* Interface */
 
-/* Pedro Miguel Andr Coelho N 68803 */
+/* Pedro Miguel André Coelho N 68803 */
 
-/******* Definio do Estrutura de Dados da Fila com Prioridade ********/
+/******* Definição do Estrutura de Dados da Fila com Prioridade ********/
 
-struct pqueue  /* definio da Fila com Prioridade */
+#define RADIX_BUCKETS 33  /* baldes do amontoado radix (0 e um por bit) - radix heap buckets (0 and one per bit) */
+#define NONE UINT_MAX  /* fim de uma lista de vértices - end of a vertex list */
+
+struct pqueue  /* definição da Fila com Prioridade */
 {
+  unsigned int Kind;  /* implementação da Fila (PQUEUE_BINARY ou PQUEUE_RADIX) - implementation of the priority queue */
   unsigned int HeapSize;  /* capacidade de armazenamento da Fila - capacity of the priority queue */
-  unsigned int NumElem;  /* nmero de elementos armazenados na Fila - number of elements stored in the priority queue */
+  unsigned int NumElem;  /* número de elementos armazenados na Fila - number of elements stored in the priority queue */
   VERTEX *Heap;  /* ponteiro para o monte a alocar dinamicamente - pointer to the priority queue array */
+  unsigned int *Pos;  /* posição (+1) de cada vértice no monte ou balde, 0 se ausente - heap slot or bucket (+1) of each vertex, 0 if absent */
+  int *Key;  /* custo de cada vértice no amontoado radix - cost of each vertex in the radix heap */
+  unsigned int *Next;  /* vértice seguinte no balde - next vertex in the bucket */
+  unsigned int *Prev;  /* vértice anterior no balde - previous vertex in the bucket */
+  unsigned int Bucket[RADIX_BUCKETS];  /* primeiro vértice de cada balde - first vertex of each bucket */
+  int Last;  /* último mínimo retirado do amontoado radix - last minimum removed from the radix heap */
 };
 
-/********************** Definio dos Subprogramas *********************/
+/************** Protótipos dos Subprogramas Internos *******************/
+
+static void SiftUp (PtPQueue, unsigned int, VERTEX *);
+static void SiftDown (PtPQueue, unsigned int, VERTEX *);
+static unsigned int RadixBucket (PtPQueue, int);
+static void RadixLink (PtPQueue, unsigned int, unsigned int);
+static void RadixUnlink (PtPQueue, unsigned int);
+static void RadixDeleteMin (PtPQueue, VERTEX *);
+
+/********************** Definição dos Subprogramas *********************/
 
 PtPQueue PQueueCreate (unsigned int pdim)
 {
 
-	PtPQueue PQueue;
+	return PQueueCreateKind (pdim, PQUEUE_BINARY);
 
-  	if (pdim == 0) return NULL;
+}
+
+PtPQueue PQueueCreateKind (unsigned int pdim, unsigned int pkind)
+{
 
- 	/* alocar memria para a Fila com Prioridade */
-  	if ((PQueue = (PtPQueue) malloc (sizeof (struct pqueue))) == NULL) return NULL;
+	PtPQueue PQueue; unsigned int B;
+
+  	if (pdim == 0 || pdim == UINT_MAX) return NULL;
+  	if (pkind != PQUEUE_BINARY && pkind != PQUEUE_RADIX) return NULL;
+
+ 	/* alocar memória para a Fila com Prioridade */
+  	if ((PQueue = (PtPQueue) calloc (1, sizeof (struct pqueue))) == NULL) return NULL;
+
+	/* tabela de posições indexada pelo número do vértice (0 a pdim) */
+	PQueue->Pos = (unsigned int *) calloc (pdim+1, sizeof (unsigned int));
+
+	if (pkind == PQUEUE_BINARY)
+		PQueue->Heap = (VERTEX *) calloc (pdim, sizeof (struct dijkstra));
+	else{
+		/* custos e listas dos baldes, indexados pelo número do vértice */
+		PQueue->Key = (int *) calloc (pdim+1, sizeof (int));
+		PQueue->Next = (unsigned int *) calloc (pdim+1, sizeof (unsigned int));
+		PQueue->Prev = (unsigned int *) calloc (pdim+1, sizeof (unsigned int));
+		for (B = 0; B < RADIX_BUCKETS; B++) PQueue->Bucket[B] = NONE;
+	}
 
-	if ((PQueue->Heap = (VERTEX *) calloc (pdim, sizeof (struct dijkstra))) == NULL){ 
-		free (PQueue);
+	if (PQueue->Pos == NULL || (pkind == PQUEUE_BINARY && PQueue->Heap == NULL) ||
+	    (pkind == PQUEUE_RADIX && (PQueue->Key == NULL || PQueue->Next == NULL || PQueue->Prev == NULL))){
+		PQueueDestroy (&PQueue);
 		return NULL;
 	}
 
-  	PQueue->HeapSize = pdim;  /* armazenar a dimenso da Fila */
-  	PQueue->NumElem = 0;  /* inicializar o nmero de elementos da Fila */
+  	PQueue->Kind = pkind;  /* armazenar a implementação da Fila */
+  	PQueue->HeapSize = pdim;  /* armazenar a dimensão da Fila */
+  	PQueue->NumElem = 0;  /* inicializar o número de elementos da Fila */
+  	PQueue->Last = 0;  /* nenhum mínimo retirado */
 
-  	return PQueue;  /* devolver a referncia da Fila acabada de criar */
+  	return PQueue;  /* devolver a referência da Fila acabada de criar */
 
 }
 
@@ -48,31 +92,63 @@ int PQueueDestroy (PtPQueue *ppqueue)
 
  	if (TmpPQueue == NULL) return NO_PQUEUE;
 
-  	free (TmpPQueue->Heap);  /* libertar a memria ocupada pelo monte */
-  	free (TmpPQueue);  /* libertar a memria ocupada pela Fila */
+  	free (TmpPQueue->Heap);  /* libertar a memória ocupada pelo monte */
+  	free (TmpPQueue->Pos);  /* libertar a memória ocupada pela tabela de posições */
+  	free (TmpPQueue->Key);  /* libertar a memória ocupada pelos baldes */
+  	free (TmpPQueue->Next);
+  	free (TmpPQueue->Prev);
+  	free (TmpPQueue);  /* libertar a memória ocupada pela Fila */
 
-  	*ppqueue = NULL;  /* colocar a referncia da Fila a NULL */
+  	*ppqueue = NULL;  /* colocar a referência da Fila a NULL */
 
   	return OK;
 
 }
 
-int PQueueInsert (PtPQueue ppqueue, VERTEX *pelem)
+int PQueueClear (PtPQueue ppqueue)
 {
 
-	unsigned int i;
+	unsigned int I, V;
+
+  	if (ppqueue == NULL) return NO_PQUEUE;
+
+	if (ppqueue->Kind == PQUEUE_RADIX){
+		/* esvaziar os baldes e recomeçar a sequência monótona */
+		for (I = 0; I < RADIX_BUCKETS; I++){
+			for (V = ppqueue->Bucket[I]; V != NONE; V = ppqueue->Next[V]) ppqueue->Pos[V] = 0;
+			ppqueue->Bucket[I] = NONE;
+		}
+		ppqueue->Last = 0;
+	}
+	else  /* retirar do monte apenas os vértices lá presentes */
+		for (I = 0; I < ppqueue->NumElem; I++) ppqueue->Pos[ppqueue->Heap[I].Vertex] = 0;
+
+  	ppqueue->NumElem = 0;
+
+  	return OK;
+
+}
+
+int PQueueInsert (PtPQueue ppqueue, VERTEX *pelem)
+{
 
   	if (ppqueue == NULL) return NO_PQUEUE;
 	if (ppqueue->NumElem == ppqueue->HeapSize) return PQUEUE_FULL;
 	if (pelem == NULL) return NULL_PTR;
+	if (pelem->Vertex > ppqueue->HeapSize) return NO_ELEM;
+	if (ppqueue->Pos[pelem->Vertex] != 0) return REP_ELEM;
+
+	if (ppqueue->Kind == PQUEUE_RADIX){
+		if (pelem->Cost < ppqueue->Last) return NO_MONOTONE;
+		/* colocar o vértice no balde correspondente ao seu custo */
+		ppqueue->Key[pelem->Vertex] = pelem->Cost;
+		RadixLink (ppqueue, pelem->Vertex, RadixBucket (ppqueue, pelem->Cost));
+		ppqueue->NumElem++;
+		return OK;
+	}
 
-  	/* ajustar o monte, descendo os pais menores do que o elemento */
-  	for (i = ppqueue->NumElem; i > 0 && ppqueue->Heap[(i-1)/2].Cost > pelem->Cost; i = (i-1)/2)
-		/* descer o pai menor do que o novo elemento */    		
-		ppqueue->Heap[i] = ppqueue->Heap[(i-1)/2];
-		
-  	ppqueue->Heap[i] = *pelem;  /* colocar o novo elemento no monte */
-  	ppqueue->NumElem++;  /* incrementar o nmero de elementos do monte */
+  	/* colocar o novo elemento no fim do monte e subi-lo até à sua posição */
+  	SiftUp (ppqueue, ppqueue->NumElem++, pelem);
 
   	return OK;
 
@@ -81,34 +157,22 @@ int PQueueInsert (PtPQueue ppqueue, VERTEX *pelem)
 int PQueueDeleteMin (PtPQueue ppqueue, VERTEX *pelem)
 {
 
-	unsigned int i, filho;  /* posio do pai e do filho */
-
   	if (ppqueue == NULL) return NO_PQUEUE;  	
 	if (ppqueue->NumElem == 0) return PQUEUE_EMPTY;
   	if (pelem == NULL) return NULL_PTR;
 
-  	*pelem = ppqueue->Heap[0];  /* retirar a raz do amontoado */
-  	ppqueue->NumElem--;  /* decrementar o nmero de elementos do amontoado */
-
-  	/* ajustar o amontoado, subindo os filhos maiores do que o elemento */
-  	for (i = 0; i*2+1 <= ppqueue->NumElem; i = filho){
-
-		filho = 2*i+1;  /* primeiro filho */
-
-    		/* determinar o maior dos filhos */
-    		if (filho < ppqueue->NumElem && ppqueue->Heap[filho].Cost > ppqueue->Heap[filho+1].Cost)
-      			filho++;
+	if (ppqueue->Kind == PQUEUE_RADIX){
+		RadixDeleteMin (ppqueue, pelem);
+		return OK;
+	}
 
-    		/* subir o filho maior do que o ltimo elemento */
-    		if (ppqueue->Heap[filho].Cost < ppqueue->Heap[ppqueue->NumElem].Cost)
-         		ppqueue->Heap[i] = ppqueue->Heap[filho];
-    		
-		else 
-			break;
-  	}
+  	*pelem = ppqueue->Heap[0];  /* retirar a raíz do amontoado */
+  	ppqueue->Pos[pelem->Vertex] = 0;  /* o vértice deixa de estar na fila */
+  	ppqueue->NumElem--;  /* decrementar o número de elementos do amontoado */
 
-  	/* recolocar o ltimo elemento no amontoado */
-  	ppqueue->Heap[i] = ppqueue->Heap[ppqueue->NumElem];
+  	/* recolocar o último elemento no amontoado, descendo-o a partir da raíz */
+  	if (ppqueue->NumElem > 0)
+		SiftDown (ppqueue, 0, &ppqueue->Heap[ppqueue->NumElem]);
 
   	return OK;
 
@@ -117,27 +181,40 @@ int PQueueDeleteMin (PtPQueue ppqueue, VERTEX *pelem)
 int PQueueDecrease (PtPQueue ppqueue, VERTEX *pelem)
 {
 
-	unsigned int i;  /* posio do pai e do filho */
+	unsigned int i;  /* posição do elemento no amontoado */
 
   	if (ppqueue == NULL) return NO_PQUEUE;
   	if (ppqueue->NumElem == 0) return PQUEUE_EMPTY;
 	if (pelem == NULL) return NULL_PTR;
 
-  	/* procurar o elemento na fila com prioridade */  
-  	for (i = 0; i < ppqueue->NumElem; i++)
-		if (ppqueue->Heap[i].Vertex == pelem->Vertex) break;
+  	/* obter a posição do elemento na fila com prioridade */  
+  	if (pelem->Vertex > ppqueue->HeapSize || ppqueue->Pos[pelem->Vertex] == 0) return NO_ELEM;
 
-  	if (i == ppqueue->NumElem) return NO_ELEM;
+	if (ppqueue->Kind == PQUEUE_RADIX){
+		if (pelem->Cost < ppqueue->Last) return NO_MONOTONE;
+		/* mudar o vértice para o balde correspondente ao novo custo */
+		RadixUnlink (ppqueue, pelem->Vertex);
+		ppqueue->Key[pelem->Vertex] = pelem->Cost;
+		RadixLink (ppqueue, pelem->Vertex, RadixBucket (ppqueue, pelem->Cost));
+		return OK;
+	}
 
-  	/* ajustar o amontoado, subindo os filhos maiores do que o elemento */
-  	for ( ; i > 0 && ppqueue->Heap[(i-1)/2].Cost > pelem->Cost; i = (i-1)/2)
-		ppqueue->Heap[i] = ppqueue->Heap[(i-1)/2];
+  	i = ppqueue->Pos[pelem->Vertex] - 1;
 
-  	ppqueue->Heap[i] = *pelem;	/* colocar o novo valor do elemento */
+  	/* ajustar o amontoado, subindo ou descendo o elemento com o novo custo */
+  	if (pelem->Cost <= ppqueue->Heap[i].Cost) SiftUp (ppqueue, i, pelem);
+  	else SiftDown (ppqueue, i, pelem);
 
 	return OK;
 
 }
+
+int PQueueContains (PtPQueue ppqueue, unsigned int pvertex)
+{
+  if (ppqueue == NULL) return NO_PQUEUE;
+  if (pvertex > ppqueue->HeapSize || ppqueue->Pos[pvertex] == 0) return NO_ELEM;
+  return OK;
+}
  
 int PQueueIsEmpty (PtPQueue ppqueue)
 {
@@ -148,11 +225,20 @@ int PQueueIsEmpty (PtPQueue ppqueue)
 
 int PQueueDisplay (PtPQueue ppqueue)
 {
-  int I;
+  int I; unsigned int V;
 
   if (ppqueue == NULL) return NO_PQUEUE;
   if (ppqueue->NumElem == 0) return PQUEUE_EMPTY;
 
+  if (ppqueue->Kind == PQUEUE_RADIX)
+  {
+    for (I = 0; I < RADIX_BUCKETS; I++)
+      for (V = ppqueue->Bucket[I]; V != NONE; V = ppqueue->Next[V])
+        printf ("(%d-%d)  ", V, ppqueue->Key[V]);
+    printf ("\n");
+    return OK;
+  }
+
   for (I = 0; I < ppqueue->NumElem; I++)
     printf ("(%d-%d)  ", ppqueue->Heap[I].Vertex, ppqueue->Heap[I].Cost);
   printf ("\n");
@@ -160,3 +246,106 @@ int PQueueDisplay (PtPQueue ppqueue)
   return OK;
 }
 
+/******************* Definição dos Subprogramas Internos ******************/
+
+/* Coloca o elemento pelem na posição i do amontoado, descendo os pais com custo maior do que o seu e atualizando as posições dos vértices deslocados. */
+
+static void SiftUp (PtPQueue ppqueue, unsigned int i, VERTEX *pelem)
+{
+	VERTEX Elem = *pelem;  /* cópia, porque pelem pode apontar para o próprio monte */
+
+	for ( ; i > 0 && ppqueue->Heap[(i-1)/2].Cost > Elem.Cost; i = (i-1)/2){
+		ppqueue->Heap[i] = ppqueue->Heap[(i-1)/2];  /* descer o pai */
+		ppqueue->Pos[ppqueue->Heap[i].Vertex] = i+1;
+	}
+
+	ppqueue->Heap[i] = Elem;
+	ppqueue->Pos[Elem.Vertex] = i+1;
+}
+
+/* Coloca o elemento pelem na posição i do amontoado, subindo os filhos com custo menor do que o seu e atualizando as posições dos vértices deslocados. */
+
+static void SiftDown (PtPQueue ppqueue, unsigned int i, VERTEX *pelem)
+{
+	VERTEX Elem = *pelem;  /* cópia, porque pelem pode apontar para o próprio monte */
+	unsigned int filho;
+
+	for ( ; i*2+1 < ppqueue->NumElem; i = filho){
+
+		filho = 2*i+1;  /* primeiro filho */
+
+		/* determinar o menor dos filhos */
+		if (filho+1 < ppqueue->NumElem && ppqueue->Heap[filho].Cost > ppqueue->Heap[filho+1].Cost)
+			filho++;
+
+		/* subir o filho menor do que o elemento */
+		if (ppqueue->Heap[filho].Cost < Elem.Cost){
+			ppqueue->Heap[i] = ppqueue->Heap[filho];
+			ppqueue->Pos[ppqueue->Heap[i].Vertex] = i+1;
+		}
+		else
+			break;
+	}
+
+	ppqueue->Heap[i] = Elem;
+	ppqueue->Pos[Elem.Vertex] = i+1;
+}
+
+/* Determina o balde do amontoado radix para o custo pcost: 0 se for igual ao último mínimo retirado, senão 1 mais a posição do bit mais significativo em que difere dele. */
+
+static unsigned int RadixBucket (PtPQueue ppqueue, int pcost)
+{
+	unsigned int Diff = (unsigned int) pcost ^ (unsigned int) ppqueue->Last, B;
+
+	for (B = 0; Diff != 0; B++) Diff >>= 1;
+	return B;
+}
+
+/* Coloca o vértice pvertex à cabeça do balde pbucket. */
+
+static void RadixLink (PtPQueue ppqueue, unsigned int pvertex, unsigned int pbucket)
+{
+	ppqueue->Prev[pvertex] = NONE;
+	ppqueue->Next[pvertex] = ppqueue->Bucket[pbucket];
+	if (ppqueue->Bucket[pbucket] != NONE) ppqueue->Prev[ppqueue->Bucket[pbucket]] = pvertex;
+	ppqueue->Bucket[pbucket] = pvertex;
+	ppqueue->Pos[pvertex] = pbucket+1;
+}
+
+/* Retira o vértice pvertex do seu balde. */
+
+static void RadixUnlink (PtPQueue ppqueue, unsigned int pvertex)
+{
+	if (ppqueue->Prev[pvertex] != NONE) ppqueue->Next[ppqueue->Prev[pvertex]] = ppqueue->Next[pvertex];
+	else ppqueue->Bucket[ppqueue->Pos[pvertex]-1] = ppqueue->Next[pvertex];
+	if (ppqueue->Next[pvertex] != NONE) ppqueue->Prev[ppqueue->Next[pvertex]] = ppqueue->Prev[pvertex];
+	ppqueue->Pos[pvertex] = 0;
+}
+
+/* Retira o menor elemento do amontoado radix, que tem de ter elementos. Se o balde 0 estiver vazio, o menor custo do primeiro balde não vazio passa a ser o último mínimo e os vértices desse balde são redistribuídos pelos baldes inferiores. */
+
+static void RadixDeleteMin (PtPQueue ppqueue, VERTEX *pelem)
+{
+	unsigned int B, V, Min, Next;
+
+	if (ppqueue->Bucket[0] == NONE){
+
+		for (B = 1; ppqueue->Bucket[B] == NONE; B++) ;  /* primeiro balde não vazio */
+
+		for (Min = V = ppqueue->Bucket[B]; V != NONE; V = ppqueue->Next[V])
+			if (ppqueue->Key[V] < ppqueue->Key[Min]) Min = V;
+		ppqueue->Last = ppqueue->Key[Min];
+
+		/* redistribuir o balde, relativamente ao novo último mínimo */
+		V = ppqueue->Bucket[B]; ppqueue->Bucket[B] = NONE;
+		for ( ; V != NONE; V = Next){
+			Next = ppqueue->Next[V];
+			RadixLink (ppqueue, V, RadixBucket (ppqueue, ppqueue->Key[V]));
+		}
+	}
+
+	V = ppqueue->Bucket[0];  /* qualquer vértice do balde 0 tem o custo mínimo */
+	RadixUnlink (ppqueue, V);
+	pelem->Vertex = V; pelem->Cost = ppqueue->Key[V];
+	ppqueue->NumElem--;
+}
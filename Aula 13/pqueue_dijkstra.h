@@ -2,13 +2,13 @@
 
  Ficheiro de interface do Tipo de Dados Abstrato Fila com Prioridade (Priority
  Queue - PQUEUE) (pqueue_dijkstra.h) orientada aos minimos, baseada num amontoado
- binrio, para armazenar elementos do tipo VERTEX. A implementao tem capacidade
- de mltipla instanciao, sendo providenciado um construtor para criar uma fila 
- com prioridade vazia.  da responsabilidade da aplicao, invocar o destructor,
- para libertar a memria atribuda ao objecto. O mdulo providencia um controlo 
- de erro no retorno das operaes. 
+ binário, para armazenar elementos do tipo VERTEX. A implementação tem capacidade
+ de múltipla instanciação, sendo providenciado um construtor para criar uma fila 
+ com prioridade vazia. É da responsabilidade da aplicação, invocar o destructor,
+ para libertar a memória atribuída ao objecto. O módulo providencia um controlo 
+ de erro no retorno das operações. 
 
- Autor : Antnio Manuel Adrego da Rocha    Data : Maio de 2015
+ Autor : António Manuel Adrego da Rocha    Data : Maio de 2015
 
  Interface file of the abstract data type Priority Queue - PQUEUE (pqueue_dijkstra.h),
  basead on a binary heap, and that stores elements of type VERTEX. The implementation
@@ -22,56 +22,96 @@
 #ifndef _PQUEUE_HEAP
 #define _PQUEUE_HEAP
 
-/************ Definio do elemento da Fila com Prioridade ************/
+/************ Definição do elemento da Fila com Prioridade ************/
 typedef struct dijkstra 
 {
   unsigned int Vertex;	/* vertex number */
   int Cost;		/* path cost to vertex */
 } VERTEX;
 
-/******* Definio do Tipo Ponteiro para uma Fila com Prioridade *******/
+/******* Definição do Tipo Ponteiro para uma Fila com Prioridade *******/
 
 typedef struct pqueue *PtPQueue;
 
-/******************** Definio de Cdigos de Erro ********************/
+/******************** Definição de Códigos de Erro ********************/
 
-#define	OK            0  /* operao realizada com sucesso - operation with success */
+#define	OK            0  /* operação realizada com sucesso - operation with success */
 #define	NO_PQUEUE     1  /* fila com prioridade inexistente - priority queue does not exist */
-#define	NO_MEM        2  /* memria esgotada - out of memory */
+#define	NO_MEM        2  /* memória esgotada - out of memory */
 #define	NULL_PTR      3  /* ponteiro nulo - null pointer */
 #define	PQUEUE_EMPTY  4  /* fila com prioridade vazia - priority queue empty */
 #define	PQUEUE_FULL   5  /* fila com prioridade cheia - priority queue full */
 #define	NO_ELEM       6  /* elemento inexistente na fila com prioridade - element does not exist in the priority queue */
+#define	REP_ELEM      7  /* elemento repetido na fila com prioridade - element already exists in the priority queue */
+#define	NO_MONOTONE   8  /* custo inferior ao último mínimo retirado - cost below the last removed minimum */
 
-/********************* Prottipos dos Subprogramas ********************/
+/************ Definição das Implementações da Fila com Prioridade ************/
+
+#define	PQUEUE_BINARY 0  /* amontoado binário - binary heap */
+#define	PQUEUE_RADIX  1  /* amontoado radix monótono - monotone radix heap */
+
+/********************* Protótipos dos Subprogramas ********************/
 
 PtPQueue PQueueCreate (unsigned int pdim);
 /*******************************************************************************
  Cria uma fila com prioridade com capacidade para armazenar pdim elementos de tipo
- VERTEX. Devolve a referncia da fila com prioridade criada ou NULL em caso de 
- inexistncia de memria ou se pdim for nulo.
+ VERTEX, com números de vértice entre 0 e pdim. A fila mantém a posição de cada
+ vértice no amontoado, pelo que cada vértice só pode estar uma vez na fila.
+ Devolve a referência da fila com prioridade criada ou NULL em caso de 
+ inexistência de memória ou se pdim for nulo.
+
+ Creates the empty priority queue with size pdim to store elements of type VERTEX,
+ with vertex numbers between 0 and pdim. The queue keeps the heap position of 
+ each vertex, so each vertex can be in the queue only once. Returns a reference
+ to the new priority queue or NULL if there isn't enough memory or if pdim is zero.
+*******************************************************************************/
 
- Creates the empty priority queue with size pdim to store elements of type VERTEX.
- Returns a reference to the new priority queue or NULL if there isn't enough memory
- or if pdim is zero.
+PtPQueue PQueueCreateKind (unsigned int pdim, unsigned int pkind);
+/*******************************************************************************
+ Cria uma fila com prioridade como PQueueCreate, escolhendo a implementação:
+ PQUEUE_BINARY (amontoado binário) ou PQUEUE_RADIX (amontoado radix monótono). O 
+ amontoado radix só aceita custos não negativos e nunca inferiores ao último 
+ mínimo retirado, como acontece no algoritmo de Dijkstra com custos inteiros não
+ negativos. Devolve a referência da fila com prioridade criada ou NULL em caso de
+ inexistência de memória, se pdim for nulo ou se pkind for desconhecido.
+
+ Creates a priority queue like PQueueCreate, choosing the implementation: 
+ PQUEUE_BINARY (binary heap) or PQUEUE_RADIX (monotone radix heap). The radix 
+ heap only accepts non-negative costs never below the last removed minimum, as in
+ Dijkstra's algorithm with non-negative integer costs. Returns a reference to the
+ new priority queue or NULL if there isn't enough memory, if pdim is zero or if 
+ pkind is unknown.
 *******************************************************************************/
 
 int PQueueDestroy (PtPQueue *ppqueue);
 /*******************************************************************************
- Destri a fila com prioridade ppqueue e coloca a referncia a NULL. Valores de
+ Destrói a fila com prioridade ppqueue e coloca a referência a NULL. Valores de
  retorno: OK ou NO_PQUEUE.
 
  Destroys the priority queue ppqueue and releases the memory. Returning error 
  codes: OK or NO_PQUEUE.
 *******************************************************************************/
 
+int PQueueClear (PtPQueue ppqueue);
+/*******************************************************************************
+ Esvazia a fila com prioridade ppqueue, em tempo proporcional ao número de 
+ elementos, para que possa ser reutilizada sem a destruir. Valores de retorno:
+ OK ou NO_PQUEUE.
+
+ Empties the priority queue ppqueue, in time proportional to the number of
+ elements, so that it can be reused without destroying it. Returning error codes:
+ OK or NO_PQUEUE.
+*******************************************************************************/
+
 int PQueueInsert (PtPQueue ppqueue, VERTEX *pelem);
 /*******************************************************************************
  Coloca pelem na fila com prioridade ppqueue. Valores de retorno: OK, NO_PQUEUE,
- PQUEUE_FULL ou NULL_PTR.
+ PQUEUE_FULL, NULL_PTR, NO_ELEM (número de vértice fora da capacidade), REP_ELEM
+ ou NO_MONOTONE (amontoado radix).
 
  Stores pelem in the priority queue ppqueue. Returning error codes: OK, NO_PQUEUE,
- PQUEUE_FULL or NULL_PTR.
+ PQUEUE_FULL, NULL_PTR, NO_ELEM (vertex number out of capacity), REP_ELEM or 
+ NO_MONOTONE (radix heap).
 *******************************************************************************/
 
 int PQueueDeleteMin (PtPQueue ppqueue, VERTEX *pelem);
@@ -85,16 +125,27 @@ int PQueueDeleteMin (PtPQueue ppqueue, VERTEX *pelem);
 
 int PQueueDecrease (PtPQueue ppqueue, VERTEX *pelem);
 /*******************************************************************************
- Promove o elemento pelem da fila com prioridade ppqueue, caso ele exista. 
- Valores de retorno: OK, NO_PQUEUE, PQUEUE_EMPTY, NULL_PTR ou NO_ELEM.
+ Promove o elemento pelem da fila com prioridade ppqueue, caso ele exista, em 
+ tempo logarítmico (amontoado binário) ou constante (amontoado radix). Valores de
+ retorno: OK, NO_PQUEUE, PQUEUE_EMPTY, NULL_PTR, NO_ELEM ou NO_MONOTONE.
+
+ Replaces pelem, if it exists in the priority queue ppqueue, in logarithmic 
+ (binary heap) or constant (radix heap) time. Returning error codes: OK, 
+ NO_PQUEUE, PQUEUE_EMPTY, NULL_PTR, NO_ELEM or NO_MONOTONE.
+*******************************************************************************/
+
+int PQueueContains (PtPQueue ppqueue, unsigned int pvertex);
+/*******************************************************************************
+ Verifica se o vértice pvertex está na fila com prioridade ppqueue, em tempo 
+ constante. Valores de retorno: OK, NO_PQUEUE ou NO_ELEM.
 
- Replaces pelem, if it exists in the priority queue ppqueue. Returning error 
- codes: OK, NO_PQUEUE, PQUEUE_EMPTY, NULL_PTR or NO_ELEM.
+ Verifies if vertex pvertex is in the priority queue ppqueue, in constant time.
+ Returning error codes: OK, NO_PQUEUE or NO_ELEM.
 *******************************************************************************/
 
 int PQueueIsEmpty (PtPQueue ppqueue);
 /*******************************************************************************
- Verifica se a fila com prioridade ppqueue est vazia. Valores de retorno: OK, 
+ Verifica se a fila com prioridade ppqueue está vazia. Valores de retorno: OK, 
  NO_PQUEUE ou PQUEUE_EMPTY.
 
  Verifies if the priority queue ppqueue is empty. Returning error codes: OK, 
@@ -1,9 +1,9 @@
 /*******************************************************************************
 
- Programa grfico de simulao da funcionalidade do TDA Digraph
+ Programa gráfico de simulação da funcionalidade do TDA Digraph
 
 
- Autor : Antnio Manuel Adrego da Rocha    Data : Maio de 2015
+ Autor : António Manuel Adrego da Rocha    Data : Maio de 2015
 
 *******************************************************************************/
 
@@ -58,7 +58,7 @@ int main (void)
         printf ("\e[0m");
       }
 
-    /* ler opo do utilizador */
+    /* ler opção do utilizador */
     ReadOption (&Option);
 
     switch (Option)
@@ -141,7 +141,7 @@ int main (void)
         case 11 : ReadDigraphIndex (&Digraph1, "digrafo");
                   if (NotActiveDigraph (DigraphArray, Digraph1)) break;
 		          ReadVertex (&Vertex1);
-                  Error = VertexType (DigraphArray[Digraph1], Vertex1);
+                  Error = VertexType (DigraphArray[Digraph1], Vertex1, NULL);
                   switch (Error)
 		          {
                      case OK     : printf("\e[1m\e[34;3fvertice normal ");  break;
@@ -164,7 +164,7 @@ int main (void)
 		             WriteErrorMessage (NO_MEM, "A determinacao dos vertices alcancaveis");
 		             break;
                   }
-                  Error = Reach (DigraphArray[Digraph1], Vertex1, VertAlc);
+                  Error = Reach (DigraphArray[Digraph1], Vertex1, VertAlc, NULL);
                   if (Error) { WriteErrorMessage (Error, "A determinacao dos vertices alcancaveis"); free(VertAlc); break; }
 		          printf("\e[1m\e[34;1f| Vertices alcancaveis: ");
                   NAlc = VertAlc[0];
@@ -191,7 +191,7 @@ int main (void)
 		             free (VertAlc);
 		             break;
                   }
-		          Error = Dijkstra (DigraphArray[Digraph1], Vertex1, VertAlc, VertCost);
+		          Error = ShortestPaths (DigraphArray[Digraph1], Vertex1, VertAlc, VertCost, NULL);
                   if (Error) { WriteErrorMessage (Error, "A determinacao dos caminhos mais curtos");
                   free(VertAlc); free (VertCost); break; }
 		          WriteAllPaths (VertAlc, VertCost, Vertex1, NVertexes);
@@ -480,16 +480,17 @@ void ReadType (unsigned int *ptype)
 
 void WriteDigraph (PtDigraph pdigraph)
 {
-  unsigned int NVertexes, Index; char VertexList[256];
-
-  VertexNumber (pdigraph, &NVertexes);
+  DIGRAPHCURSOR Vertexes, Edges; unsigned int Line = 7, V1, V2; int Cost;
 
   printf("\e[1m");
-  for (Index = 1; Index <= NVertexes; Index++)
+  DigraphVertexBegin (pdigraph, &Vertexes);
+  while (DigraphVertexNext (&Vertexes, &V1, NULL, NULL) == OK)
   {
-    GetVertexList (pdigraph, Index, VertexList);
-    printf("\e[%d;66f ", 6+Index);
-    printf ("%s\n", VertexList);
+    printf("\e[%d;66f ", Line++);
+    printf ("Vertice %2d > ", V1);
+    DigraphEdgeBegin (pdigraph, V1, &Edges);
+    while (DigraphEdgeNext (&Edges, &V2, &Cost) == OK) printf ("%2d (%2d) ", V2, Cost);
+    printf ("\n");
   }
   printf("\e[0m");
 }
@@ -501,7 +502,7 @@ void WriteAllPaths (unsigned int pvpred[], int pcost[], unsigned int pvertex, un
   printf ("\e[1m\e[5;67fCaminhos mais curtos a partir do vertice %d\n", pvertex);
 
   for (I = 1; I <= pnv; I++)
-    if (pvpred[I-1] != 0)  /* vrtice alcanvel */
+    if (pvpred[I-1] != 0)  /* vértice alcançável */
     {
       printf ("\e[%d;67f", 5+I); 
       WritePath (pvpred, I);